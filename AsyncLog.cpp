@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "AsyncLog.hpp"
+#include "Clock.hpp"
+
+namespace shipcontrol
+{
+
+static std::atomic<std::uint64_t> async_log_ids(1);
+
+// ring of the current thread, valid for the AsyncLog instance with the given id
+struct AsyncLogRingCache
+{
+    std::uint64_t id;
+    void *ring;
+};
+static thread_local AsyncLogRingCache ring_cache = { 0, nullptr };
+
+AsyncLog::AsyncLog(unsigned int ring_size, unsigned int flush_interval) :
+    _id(async_log_ids.fetch_add(1)),
+    _ring_size(ring_size),
+    _flush_interval(flush_interval),
+    _reported_dropped(0),
+    _need_to_stop(false)
+{
+    _thread = std::thread(&AsyncLog::run, this);
+}
+
+AsyncLog::~AsyncLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(_stop_mutex);
+        _need_to_stop = true;
+    }
+    _stop_cond.notify_one();
+    _thread.join();
+    flush();
+}
+
+void AsyncLog::add_target(LogBackend *target)
+{
+    if (target != nullptr)
+    {
+        _targets.push_back(target);
+    }
+}
+
+AsyncLog::Ring *AsyncLog::get_ring()
+{
+    if (ring_cache.id == _id)
+    {
+        return static_cast<Ring *>(ring_cache.ring);
+    }
+
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    Ring *ring = nullptr;
+    std::thread::id owner = std::this_thread::get_id();
+    for (std::size_t i = 0; i < _rings.size(); i++)
+    {
+        if (_ring_owners[i] == owner)
+        {
+            ring = _rings[i].get();
+            break;
+        }
+    }
+    if (ring == nullptr)
+    {
+        _rings.emplace_back(new Ring(_ring_size));
+        _ring_owners.push_back(owner);
+        ring = _rings.back().get();
+    }
+
+    ring_cache.id = _id;
+    ring_cache.ring = ring;
+    return ring;
+}
+
+void AsyncLog::write(const char *fmt, va_list args)
+{
+    Ring *ring = get_ring();
+
+    unsigned int head = ring->head.load(std::memory_order_relaxed);
+    unsigned int tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail >= _ring_size)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record &record = ring->records[head % _ring_size];
+    record.time = monotonic_now();
+    if (std::vsnprintf(record.text, ASYNC_LOG_RECORD_SIZE, fmt, args) < 0)
+    {
+        record.text[0] = '\0';
+    }
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void AsyncLog::flush()
+{
+    std::lock_guard<std::mutex> flush_lock(_flush_mutex);
+
+    std::vector<Ring *> rings;
+    {
+        std::lock_guard<std::mutex> lock(_rings_mutex);
+        for (auto &ring : _rings)
+        {
+            rings.push_back(ring.get());
+        }
+    }
+
+    // merge pending records of all rings in time order
+    std::vector<unsigned int> heads(rings.size());
+    std::vector<unsigned int> positions(rings.size());
+    std::uint64_t dropped = 0;
+    for (std::size_t i = 0; i < rings.size(); i++)
+    {
+        heads[i] = rings[i]->head.load(std::memory_order_acquire);
+        positions[i] = rings[i]->tail.load(std::memory_order_relaxed);
+        dropped += rings[i]->dropped.load(std::memory_order_relaxed);
+    }
+
+    while (true)
+    {
+        Ring *next = nullptr;
+        std::size_t next_index = 0;
+        for (std::size_t i = 0; i < rings.size(); i++)
+        {
+            if ((positions[i] != heads[i]) &&
+                ((next == nullptr) ||
+                 (rings[i]->records[positions[i] % _ring_size].time <
+                  next->records[positions[next_index] % _ring_size].time)))
+            {
+                next = rings[i];
+                next_index = i;
+            }
+        }
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        const Record &record = next->records[positions[next_index] % _ring_size];
+        for (LogBackend *target : _targets)
+        {
+            forward(target, "%s", record.text);
+        }
+        positions[next_index]++;
+        // the slot may be reused by the producer right away
+        next->tail.store(positions[next_index], std::memory_order_release);
+    }
+
+    if (dropped != _reported_dropped)
+    {
+        for (LogBackend *target : _targets)
+        {
+            forward(target, "AsyncLog dropped %llu messages\n",
+                    static_cast<unsigned long long>(dropped - _reported_dropped));
+        }
+        _reported_dropped = dropped;
+    }
+}
+
+std::uint64_t AsyncLog::get_dropped()
+{
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    std::uint64_t dropped = 0;
+    for (auto &ring : _rings)
+    {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+void AsyncLog::run()
+{
+    std::unique_lock<std::mutex> lock(_stop_mutex);
+    while (_need_to_stop == false)
+    {
+        _stop_cond.wait_for(lock, std::chrono::milliseconds(_flush_interval));
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void AsyncLog::forward(LogBackend *target, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    target->write(fmt, args);
+    va_end(args);
+}
+
+} // namespace shipcontrol
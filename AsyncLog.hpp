@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASYNCLOG_HPP
+#define ASYNCLOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+// max length of a single message, longer messages are truncated
+#define ASYNC_LOG_RECORD_SIZE       256
+// default number of records in a per-thread ring
+#define ASYNC_LOG_RING_SIZE         128
+// default interval of draining rings, milliseconds
+#define ASYNC_LOG_FLUSH_INTERVAL    10
+
+/*
+ * Log backend, which moves writing to the target backends (console, syslog)
+ * off the calling thread.
+ * Every thread writing to the log gets its own ring of fixed-size records,
+ * which is allocated on the first write. Messages are formatted directly into
+ * the ring and time stamped, so writing never blocks and doesn't allocate.
+ * A background thread periodically drains all rings in time order into the
+ * target backends. If a ring is full, the message is dropped; number of
+ * dropped messages is reported to the targets.
+ */
+class AsyncLog : public LogBackend
+{
+public:
+    AsyncLog(unsigned int ring_size = ASYNC_LOG_RING_SIZE,
+             unsigned int flush_interval = ASYNC_LOG_FLUSH_INTERVAL);
+    AsyncLog(const AsyncLog &other) = delete;
+    // drains remaining messages
+    virtual ~AsyncLog();
+
+    // targets must be added before the first write
+    void add_target(LogBackend *target);
+
+    virtual void write(const char *fmt, va_list args);
+
+    // drain all rings now
+    void flush();
+    std::uint64_t get_dropped();
+
+protected:
+    struct Record
+    {
+        // CLOCK_MONOTONIC time in nanoseconds
+        long long time;
+        char text[ASYNC_LOG_RECORD_SIZE];
+    };
+
+    // single producer (the owner thread), single consumer (flusher) ring
+    struct Ring
+    {
+        Ring(unsigned int size) : records(new Record[size]), head(0), tail(0), dropped(0) {}
+
+        std::unique_ptr<Record[]> records;
+        alignas(64) std::atomic<unsigned int> head;
+        alignas(64) std::atomic<unsigned int> tail;
+        std::atomic<std::uint64_t> dropped;
+    };
+
+    Ring *get_ring();
+    void run();
+    static void forward(LogBackend *target, const char *fmt, ...);
+
+    // unique id of the instance, used to validate per-thread ring cache
+    std::uint64_t _id;
+    unsigned int _ring_size;
+    unsigned int _flush_interval;
+    std::vector<LogBackend *> _targets;
+
+    // protects the list of rings
+    std::mutex _rings_mutex;
+    std::vector<std::unique_ptr<Ring>> _rings;
+    std::vector<std::thread::id> _ring_owners;
+
+    // serializes draining
+    std::mutex _flush_mutex;
+    std::uint64_t _reported_dropped;
+
+    std::mutex _stop_mutex;
+    std::condition_variable _stop_cond;
+    bool _need_to_stop;
+    std::thread _thread;
+};
+
+} // namespace shipcontrol
+
+#endif // ASYNCLOG_HPP
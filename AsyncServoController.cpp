@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "AsyncServoController.hpp"
+#include "Clock.hpp"
+
+namespace shipcontrol
+{
+
+AsyncServoController::AsyncServoController(ServoController *controller, const std::string &name) :
+    _controller(controller),
+    _name(name),
+    _speed{0, false, 0, 0, 0},
+    _steering{0, false, 0, 0, 0},
+    _replaced(0),
+    _need_to_stop(false),
+    _journal(nullptr),
+    _latency_stats(nullptr)
+{
+    _log = Log::getInstance();
+    _last_speed = _controller->get_speed_setpoint();
+    _last_steering = _controller->get_steering_setpoint();
+    _drives_speed = _controller->drives_speed();
+    _drives_steering = _controller->drives_steering();
+    _thread = std::thread(&AsyncServoController::run, this);
+}
+
+AsyncServoController::~AsyncServoController()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _need_to_stop = true;
+    }
+    _cond.notify_one();
+    // pending setpoints are applied before the worker exits
+    _thread.join();
+
+    log_latency_stats();
+    delete _controller;
+    Log::release();
+}
+
+Setpoint AsyncServoController::get_speed_setpoint()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _last_speed;
+}
+
+void AsyncServoController::set_speed_setpoint(Setpoint speed)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _last_speed = speed;
+        post(_speed, speed);
+    }
+    _cond.notify_one();
+}
+
+Setpoint AsyncServoController::get_steering_setpoint()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _last_steering;
+}
+
+void AsyncServoController::set_steering_setpoint(Setpoint steering)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _last_steering = steering;
+        post(_steering, steering);
+    }
+    _cond.notify_one();
+}
+
+bool AsyncServoController::set_ramp(const RampConfig &config)
+{
+    std::lock_guard<std::mutex> lock(_apply_mutex);
+    return _controller->set_ramp(config);
+}
+
+void AsyncServoController::start()
+{
+    std::lock_guard<std::mutex> lock(_apply_mutex);
+    _controller->start();
+}
+
+void AsyncServoController::stop()
+{
+    std::lock_guard<std::mutex> lock(_apply_mutex);
+    _controller->stop();
+}
+
+void AsyncServoController::post(Pending &pending, Setpoint value)
+{
+    long long input = (_latency_stats != nullptr) ? _latency_stats->get_command_time() : 0;
+    if (pending.is_set)
+    {
+        _replaced++;
+        if (pending.input == 0)
+        {
+            pending.input = input;
+        }
+    }
+    else
+    {
+        pending.is_set = true;
+        pending.posted = monotonic_now();
+        pending.input = input;
+        pending.command = 0;
+    }
+    if (input != 0)
+    {
+        pending.command = _latency_stats->get_command_seq();
+    }
+    pending.value = value;
+}
+
+void AsyncServoController::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true)
+    {
+        _cond.wait(lock, [this] { return _speed.is_set || _steering.is_set || _need_to_stop; });
+        if ((_speed.is_set == false) && (_steering.is_set == false))
+        {
+            break;
+        }
+
+        Pending speed = _speed;
+        Pending steering = _steering;
+        _speed.is_set = false;
+        _steering.is_set = false;
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> apply_lock(_apply_mutex);
+            if (speed.is_set)
+            {
+                _controller->set_speed_setpoint(speed.value);
+                if (_drives_speed)
+                {
+                    record_latency(speed);
+                    if (_journal != nullptr)
+                    {
+                        _journal->record_output(JournalEntryKind::SPEED_OUTPUT, _name, speed.value);
+                    }
+                }
+            }
+            if (steering.is_set)
+            {
+                _controller->set_steering_setpoint(steering.value);
+                if (_drives_steering)
+                {
+                    record_latency(steering);
+                    if (_journal != nullptr)
+                    {
+                        _journal->record_output(JournalEntryKind::STEERING_OUTPUT, _name, steering.value);
+                    }
+                }
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+void AsyncServoController::record_latency(const Pending &pending)
+{
+    long long now = monotonic_now();
+    _latency.record(now - pending.posted);
+    if (_latency_stats != nullptr)
+    {
+        _latency_stats->record(LatencyStage::APPLY, now - pending.posted);
+        if ((pending.input != 0) && _latency_stats->claim_total(pending.command))
+        {
+            _latency_stats->record(LatencyStage::TOTAL, now - pending.input);
+        }
+    }
+}
+
+void AsyncServoController::log_latency_stats()
+{
+    if (_latency.get_count() == 0)
+    {
+        return;
+    }
+
+    _log->write(LogLevel::NOTICE,
+                "AsyncServoController %s: %llu setpoints applied, %llu replaced, latency p50 %llu ns, p99 %llu ns, max %llu ns\n",
+                _name.c_str(),
+                static_cast<unsigned long long>(_latency.get_count()),
+                _replaced.load(),
+                static_cast<unsigned long long>(_latency.get_percentile(0.5)),
+                static_cast<unsigned long long>(_latency.get_percentile(0.99)),
+                static_cast<unsigned long long>(_latency.get_max()));
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASYNCSERVOCONTROLLER_HPP
+#define ASYNCSERVOCONTROLLER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "ServoController.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyStats.hpp"
+#include "Journal.hpp"
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * ServoController decorator, which applies setpoints to the wrapped
+ * controller from its own worker thread, so that a controller blocked on
+ * slow I/O doesn't delay the others.
+ * Setters post the setpoint and return immediately. A setpoint posted before
+ * the previous one has been applied replaces it, so the worker always applies
+ * the latest value. Time from posting to completion of the apply is recorded
+ * in the latency histogram and, if set, in the "apply" stage of shared
+ * latency stats; time from the input of the command being handled by the
+ * posting thread (see LatencyStats::get_command_time()) is recorded in the
+ * "total" stage by the first controller completing the command. Latency is
+ * recorded only for the axes driven by the wrapped controller.
+ * The wrapped controller is owned by the decorator.
+ */
+class AsyncServoController : public ServoController
+{
+public:
+    AsyncServoController(ServoController *controller, const std::string &name);
+    AsyncServoController(const AsyncServoController &other) = delete;
+    virtual ~AsyncServoController();
+
+    // ServoController implementation, getters return the latest posted setpoints
+    virtual Setpoint get_speed_setpoint();
+    virtual void set_speed_setpoint(Setpoint speed);
+    virtual Setpoint get_steering_setpoint();
+    virtual void set_steering_setpoint(Setpoint steering);
+    virtual bool set_ramp(const RampConfig &config);
+    virtual bool drives_speed() { return _drives_speed; }
+    virtual bool drives_steering() { return _drives_steering; }
+
+    virtual void start();
+    virtual void stop();
+
+    // record applied setpoints to the journal, must be set before the first setpoint is posted
+    void set_journal(Journal *journal) { _journal = journal; }
+    // record latency to shared stats, must be set before the first setpoint is posted
+    void set_latency_stats(LatencyStats *stats) { _latency_stats = stats; }
+
+    const std::string &get_name() const { return _name; }
+    // nanoseconds from posting a setpoint to its application
+    const LatencyHistogram &get_latency_stats() const { return _latency; }
+    // number of setpoints replaced by newer ones before being applied
+    unsigned long long get_replaced() const { return _replaced; }
+    void log_latency_stats();
+
+protected:
+    struct Pending
+    {
+        Setpoint value;
+        bool is_set;
+        // posting time of the oldest setpoint not applied yet
+        long long posted;
+        // input time of the oldest command not applied yet, 0 if unknown
+        long long input;
+        // sequence number of the latest command, 0 if unknown
+        unsigned long long command;
+    };
+
+    void run();
+    void post(Pending &pending, Setpoint value);
+    void record_latency(const Pending &pending);
+
+    ServoController *_controller;
+    std::string _name;
+    // protects pending setpoints and the stop flag
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    Pending _speed;
+    Pending _steering;
+    Setpoint _last_speed;
+    Setpoint _last_steering;
+    // axes driven by the wrapped controller, outputs of other axes aren't recorded
+    bool _drives_speed;
+    bool _drives_steering;
+    std::atomic<unsigned long long> _replaced;
+    bool _need_to_stop;
+    // serializes calls to the wrapped controller
+    std::mutex _apply_mutex;
+    std::thread _thread;
+    LatencyHistogram _latency;
+    Journal *_journal;
+    LatencyStats *_latency_stats;
+    Log *_log;
+};
+
+} // namespace shipcontrol
+
+#endif // ASYNCSERVOCONTROLLER_HPP
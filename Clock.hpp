@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2016 - 2018 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <ctime>
+
+namespace shipcontrol
+{
+
+// CLOCK_MONOTONIC time in nanoseconds, the time base of all latency measurements
+inline long long monotonic_now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+} // namespace shipcontrol
+
+#endif // CLOCK_HPP
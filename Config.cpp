@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2025 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -31,8 +31,13 @@ namespace shipcontrol
 
 Config::Config(const std::string &filename) :
     _is_ok(true),
+    _multi_target(false),
+    _telemetry_period(0),
     _logLevel(LogLevel::ERROR),
-    _water_cooling_relay_config(nullptr)
+    _water_cooling_relay_config(nullptr),
+    _coalesce_input(true),
+    _async_log(true),
+    _latency_log_period(60)
 {
     // prepare internal string-to-value maps for:
     // 1. Linux input keys
@@ -309,6 +314,15 @@ void Config::parse(const std::string &filename)
         _dir_low = MaestroConfig::DEFAULT_DIR_LOW;
     }
 
+    if (j.find("maestro_multi_target") != j.end())
+    {
+        _multi_target = j["maestro_multi_target"].get<bool>();
+    }
+    if (j.find("maestro_telemetry_period") != j.end())
+    {
+        _telemetry_period = j["maestro_telemetry_period"].get<unsigned int>();
+    }
+
     // get keymap
     if (j.find("keymap") != j.end())
     {
@@ -375,6 +389,12 @@ void Config::parse(const std::string &filename)
         _is_ok = false;
     }
 
+    // get metrics socket name
+    if (j.find("metrics_socket") != j.end())
+    {
+        _metrics_socket = j["metrics_socket"].get<std::string>();
+    }
+
     // get log backends
     if (j.find("logbackends") != j.end())
     {
@@ -411,6 +431,113 @@ void Config::parse(const std::string &filename)
         _logLevel = LogLevel::NOTICE;
     }
 
+    // asynchronous logging
+    if (j.find("async_log") != j.end())
+    {
+        _async_log = j["async_log"].get<bool>();
+    }
+
+    // latency summary
+    if (j.find("latency_log_period") != j.end())
+    {
+        _latency_log_period = j["latency_log_period"].get<unsigned int>();
+    }
+
+    // input event coalescing
+    if (j.find("coalesce_input") != j.end())
+    {
+        _coalesce_input = j["coalesce_input"].get<bool>();
+    }
+
+    // setpoint ramping
+    if (j.find("ramp") != j.end())
+    {
+        auto ramp = j["ramp"];
+        if (ramp.find("tick_rate") != ramp.end())
+        {
+            _ramp_config.tick_rate = ramp["tick_rate"].get<unsigned int>();
+        }
+        if (ramp.find("speed_rate") != ramp.end())
+        {
+            _ramp_config.speed.rate = ramp["speed_rate"].get<unsigned int>();
+        }
+        if (ramp.find("speed_accel") != ramp.end())
+        {
+            _ramp_config.speed.accel = ramp["speed_accel"].get<unsigned int>();
+        }
+        if (ramp.find("steering_rate") != ramp.end())
+        {
+            _ramp_config.steering.rate = ramp["steering_rate"].get<unsigned int>();
+        }
+        if (ramp.find("steering_accel") != ramp.end())
+        {
+            _ramp_config.steering.accel = ramp["steering_accel"].get<unsigned int>();
+        }
+    }
+
+    // event journal
+    if (j.find("journal") != j.end())
+    {
+        auto journal = j["journal"];
+        if (journal.find("path") != journal.end())
+        {
+            _journal_config.path = journal["path"].get<std::string>();
+        }
+        if (journal.find("entries") != journal.end())
+        {
+            _journal_config.entries = journal["entries"].get<unsigned int>();
+        }
+        if (journal.find("sync_period") != journal.end())
+        {
+            _journal_config.sync_period = journal["sync_period"].get<unsigned int>();
+        }
+    }
+
+    // hardware-free simulation
+    if (j.find("simulation") != j.end())
+    {
+        auto simulation = j["simulation"];
+        if (simulation.find("gpio") != simulation.end())
+        {
+            _simulation_config.gpio = simulation["gpio"].get<bool>();
+        }
+        if (simulation.find("controllers") != simulation.end())
+        {
+            _simulation_config.controllers = simulation["controllers"].get<unsigned int>();
+        }
+        if (simulation.find("controller_delay") != simulation.end())
+        {
+            _simulation_config.controller_delay = simulation["controller_delay"].get<unsigned int>();
+        }
+        if (simulation.find("maestro") != simulation.end())
+        {
+            _simulation_config.maestro = simulation["maestro"].get<bool>();
+        }
+        if (simulation.find("sysfs_pwm") != simulation.end())
+        {
+            _simulation_config.sysfs_pwm = simulation["sysfs_pwm"].get<std::string>();
+        }
+    }
+
+    // SW PWM thread scheduling
+    GPIOPWMRealtimeConfig pwm_realtime;
+    if (j.find("sw_pwm_realtime") != j.end())
+    {
+        auto realtime = j["sw_pwm_realtime"];
+        if (realtime.find("priority") != realtime.end())
+        {
+            pwm_realtime.priority = realtime["priority"].get<int>();
+        }
+        if (realtime.find("cpu") != realtime.end())
+        {
+            pwm_realtime.cpu = realtime["cpu"].get<int>();
+        }
+        if (realtime.find("lock_memory") != realtime.end())
+        {
+            pwm_realtime.lock_memory = realtime["lock_memory"].get<bool>();
+        }
+    }
+
     // get GPIO engine settings
     if (j.find("gpio_engines") != j.end())
     {
@@ -418,6 +545,7 @@ void Config::parse(const std::string &filename)
         for (auto gpio_engine : gpio_engines)
         {
             GPIOEngineConfig gpio_engine_config;
+            gpio_engine_config.pwm_realtime = pwm_realtime;
 
             if (gpio_engine.find("chip_path") != gpio_engine.end())
             {
@@ -489,6 +617,7 @@ void Config::parse(const std::string &filename)
         for (auto gpio_steering : gpio_steering_array)
         {
             GPIOSteeringConfig gpio_steering_config;
+            gpio_steering_config.pwm_realtime = pwm_realtime;
 
             if (gpio_steering.find("chip_path") != gpio_steering.end())
             {
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2025 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -28,6 +28,9 @@
 #include "GPIOEngineConfig.hpp"
 #include "GPIOSteeringConfig.hpp"
 #include "GPIOSwitchConfig.hpp"
+#include "RampConfig.hpp"
+#include "JournalConfig.hpp"
+#include "SimulationConfig.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -54,8 +57,11 @@ public:
     virtual SteeringCalibration get_steering_calibration() { return _steering_calibration; }
     virtual int get_direction_high() { return _dir_high; }
     virtual int get_direction_low() { return _dir_low; }
+    virtual bool get_multi_target() { return _multi_target; }
+    virtual unsigned int get_telemetry_period() { return _telemetry_period; }
     // IPCConfig
     virtual std::string get_unix_socket_name() { return _unix_socket; }
+    virtual std::string get_metrics_socket_name() { return _metrics_socket; }
     // GPIO configuration
     std::vector<GPIOEngineConfig> get_gpio_engine_configs() { return _gpio_engine_configs; }
     std::vector<GPIOSteeringConfig> get_gpio_steering_configs() { return _gpio_steering_configs; }
@@ -64,6 +70,12 @@ public:
     // general configuration
     std::vector<LogBackendType> get_log_backends() { return _logBackends; }
     LogLevel get_log_level() { return _logLevel; }
+    bool get_coalesce_input() { return _coalesce_input; }
+    bool get_async_log() { return _async_log; }
+    unsigned int get_latency_log_period() { return _latency_log_period; }
+    RampConfig get_ramp_config() { return _ramp_config; }
+    JournalConfig get_journal_config() { return _journal_config; }
+    SimulationConfig get_simulation_config() { return _simulation_config; }
 
     bool is_ok() { return _is_ok; }
 
@@ -74,6 +86,8 @@ protected:
     SteeringCalibration _steering_calibration;
     int _dir_high;
     int _dir_low;
+    bool _multi_target;
+    unsigned int _telemetry_period;
     std::string _maestro_dev;
     std::unordered_map<std::string, int> _keystring_map;
     std::unordered_map<std::string, RelEvent> _relstring_map;
@@ -81,11 +95,18 @@ protected:
     key_map _keymap;
     rel_map _relmap;
     std::string _unix_socket;
+    std::string _metrics_socket;
     std::vector<GPIOEngineConfig> _gpio_engine_configs;
     std::vector<GPIOSteeringConfig> _gpio_steering_configs;
     GPIOSwitchConfig *_water_cooling_relay_config;
     std::vector<LogBackendType> _logBackends;
     LogLevel _logLevel;
+    bool _coalesce_input;
+    bool _async_log;
+    unsigned int _latency_log_period;
+    RampConfig _ramp_config;
+    JournalConfig _journal_config;
+    SimulationConfig _simulation_config;
 
     void parse(const std::string &filename);
 };
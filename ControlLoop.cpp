@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ControlLoop.hpp"
+
+namespace shipcontrol
+{
+
+ControlLoop::ControlLoop(const RampConfig &config, std::vector<ServoController*> &controllers) :
+    _enabled(config.is_enabled()),
+    _tick_period(1000000000LL / ((config.tick_rate != 0) ? config.tick_rate : 1)),
+    _speed_ramp(config.speed, config.tick_rate),
+    _steering_ramp(config.steering, config.tick_rate)
+{
+    for (ServoController *controller : controllers)
+    {
+        if (_enabled && (controller->set_ramp(config) == false))
+        {
+            _sw_ramped.push_back(controller);
+        }
+        else
+        {
+            _hw_ramped.push_back(controller);
+        }
+    }
+}
+
+void ControlLoop::set_speed_target(Setpoint speed)
+{
+    for (ServoController *controller : _hw_ramped)
+    {
+        controller->set_speed_setpoint(speed);
+    }
+
+    if (_speed_ramp.is_limited())
+    {
+        _speed_ramp.set_target(speed);
+    }
+    else
+    {
+        // unlimited channel doesn't wait for the next tick
+        _speed_ramp.reset(speed);
+        for (ServoController *controller : _sw_ramped)
+        {
+            controller->set_speed_setpoint(speed);
+        }
+    }
+}
+
+void ControlLoop::set_steering_target(Setpoint steering)
+{
+    for (ServoController *controller : _hw_ramped)
+    {
+        controller->set_steering_setpoint(steering);
+    }
+
+    if (_steering_ramp.is_limited())
+    {
+        _steering_ramp.set_target(steering);
+    }
+    else
+    {
+        // unlimited channel doesn't wait for the next tick
+        _steering_ramp.reset(steering);
+        for (ServoController *controller : _sw_ramped)
+        {
+            controller->set_steering_setpoint(steering);
+        }
+    }
+}
+
+bool ControlLoop::is_active() const
+{
+    return (_speed_ramp.is_settled() == false) || (_steering_ramp.is_settled() == false);
+}
+
+void ControlLoop::tick()
+{
+    if (_speed_ramp.tick())
+    {
+        for (ServoController *controller : _sw_ramped)
+        {
+            controller->set_speed_setpoint(_speed_ramp.get_output());
+        }
+    }
+    if (_steering_ramp.tick())
+    {
+        for (ServoController *controller : _sw_ramped)
+        {
+            controller->set_steering_setpoint(_steering_ramp.get_output());
+        }
+    }
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONTROLLOOP_HPP
+#define CONTROLLOOP_HPP
+
+#include <vector>
+
+#include "ServoController.hpp"
+#include "RampConfig.hpp"
+#include "ServoRamp.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Fixed-rate control loop between ShipControl and servo controllers.
+ * Speed and steering targets are ramped toward with configured limits and
+ * only changed outputs are pushed to controllers. Controllers, which are able
+ * to ramp in hardware, get targets directly.
+ * The loop doesn't own a thread: the owner calls tick() every tick period
+ * while is_active() returns true, so controllers are only accessed from
+ * the owner's thread.
+ */
+class ControlLoop
+{
+public:
+    ControlLoop(const RampConfig &config, std::vector<ServoController*> &controllers);
+
+    void set_speed_target(Setpoint speed);
+    void set_steering_target(Setpoint steering);
+    Setpoint get_speed_output() const { return _speed_ramp.get_output(); }
+    Setpoint get_steering_output() const { return _steering_ramp.get_output(); }
+
+    // true while any of the outputs hasn't reached its target
+    bool is_active() const;
+    long long get_tick_period() const { return _tick_period; }
+    void tick();
+
+protected:
+    bool _enabled;
+    // nanoseconds
+    long long _tick_period;
+    ServoRamp _speed_ramp;
+    ServoRamp _steering_ramp;
+    // controllers ramped by the loop and the ones ramping in hardware
+    std::vector<ServoController*> _sw_ramped;
+    std::vector<ServoController*> _hw_ramped;
+};
+
+} // namespace shipcontrol
+
+#endif // CONTROLLOOP_HPP
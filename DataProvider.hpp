@@ -21,7 +21,9 @@
 #ifndef DATAPROVIDER_HPP
 #define DATAPROVIDER_HPP
 
-#include "ServoController.hpp" // included for SpeedVal/SteeringVal definitions
+#include "ServoController.hpp" // included for Setpoint definition
+#include "MaestroTelemetry.hpp"
+#include "LatencyStats.hpp"
 
 namespace shipcontrol
 {
@@ -34,8 +36,12 @@ namespace shipcontrol
 class DataProvider
 {
 public:
-    virtual SpeedVal get_speed() = 0;
-    virtual SteeringVal get_steering() = 0;
+    virtual Setpoint get_speed_setpoint() = 0;
+    virtual Setpoint get_steering_setpoint() = 0;
+    // returns false if telemetry isn't available
+    virtual bool get_maestro_telemetry(MaestroTelemetryData &/*data*/) { return false; }
+    // returns nullptr if latency isn't measured
+    virtual LatencyStats *get_latency_stats() { return nullptr; }
 };
 
 } // namespace shipcontrol
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2023 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,11 +19,13 @@
  */
 
 #include "EvdevReader.hpp"
+#include "Clock.hpp"
 #include <chrono>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <ctime>
 
 namespace shipcontrol
 {
@@ -37,7 +39,9 @@ EvdevReader::EvdevReader(EvdevConfig &config,
 : _config(config),
   _dev(dev),
   _queue(queue),
-  _fd(-1)
+  _fd(-1),
+  _latency_stats(nullptr),
+  _monotonic_time(false)
 {
     _log = Log::getInstance();
     _keymap = config.get_keymap();
@@ -101,8 +105,7 @@ void EvdevReader::handle_event(input_event &event)
         auto match = _keymap->find(event.code);
         if (match != _keymap->end())
         {
-            InputEvent evt{match->second, ""};
-            _queue.push(evt);
+            push_event(match->second, event);
         }
     }
 
@@ -112,12 +115,28 @@ void EvdevReader::handle_event(input_event &event)
         auto match = _relmap->find(rel);
         if (match != _relmap->end())
         {
-            InputEvent evt{match->second, ""};
-            _queue.push(evt);
+            push_event(match->second, event);
         }
     }
 }
 
+void EvdevReader::push_event(InputEventType type, const input_event &event)
+{
+    InputEvent evt{type};
+    evt.source = InputSource::EVDEV;
+    long long now = monotonic_now();
+    evt.time = now;
+    if (_monotonic_time)
+    {
+        evt.time = event.input_event_sec * 1000000000LL + event.input_event_usec * 1000LL;
+        if (_latency_stats != nullptr)
+        {
+            _latency_stats->record(LatencyStage::EVDEV, now - evt.time);
+        }
+    }
+    _queue.push(evt);
+}
+
 bool EvdevReader::setup()
 {
     _fd = open(_dev.c_str(), O_RDONLY | O_NONBLOCK);
@@ -138,6 +157,10 @@ bool EvdevReader::setup()
         return false;
     }
 
+    // kernel uses CLOCK_REALTIME for event time by default
+    int clock_id = CLOCK_MONOTONIC;
+    _monotonic_time = (ioctl(_fd, EVIOCSCLOCKID, &clock_id) == 0);
+
     return true;
 }
 
@@ -24,6 +24,7 @@
 #include "EvdevConfig.hpp"
 #include "Log.hpp"
 #include "SingleThread.hpp"
+#include "LatencyStats.hpp"
 #include <linux/input.h>
 #include <string>
 #include <thread>
@@ -41,6 +42,9 @@ public:
 
     virtual void run();
     virtual void stop();
+
+    // measure latency of event delivery, must be set before start()
+    void set_latency_stats(LatencyStats *stats) { _latency_stats = stats; }
 protected:
     EvdevConfig &_config;
     std::string _dev;
@@ -49,8 +53,12 @@ protected:
     int _fd;
     const key_map *_keymap;
     const rel_map *_relmap;
+    LatencyStats *_latency_stats;
+    // true if the kernel reports event time using CLOCK_MONOTONIC
+    bool _monotonic_time;
 
     void handle_event(input_event &event);
+    void push_event(InputEventType type, const input_event &event);
     bool setup();
     void teardown();
 };
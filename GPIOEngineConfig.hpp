@@ -22,6 +22,8 @@
 
 #include <string>
 
+#include "GPIOPWMConfig.hpp"
+
 namespace shipcontrol
 {
 
@@ -53,6 +55,8 @@ struct GPIOEngineConfig
     unsigned int min_duty_cycle = 10;
     unsigned int max_duty_cycle = 20;
     GPIOReverseMode reverse_mode = GPIOReverseMode::NO_REVERSE;
+    // SW PWM thread scheduling, shared by all SW PWM lines
+    GPIOPWMRealtimeConfig pwm_realtime;
 };
 
 } // namespace shipcontrol
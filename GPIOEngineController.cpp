@@ -32,9 +32,9 @@ namespace shipcontrol
 {
 
 GPIOEngineController::GPIOEngineController(const GPIOEngineConfig &config) :
-    _cur_speed(SpeedVal::STOP),
+    _cur_speed(0),
     _gpio_chip(nullptr),
-    _syspwm_path("")
+    _syspwm(nullptr)
 {
     _chip_path = config.chip_path;
     _engine_line_num = config.engine_line;
@@ -46,21 +46,20 @@ GPIOEngineController::GPIOEngineController(const GPIOEngineConfig &config) :
 
     _log = Log::getInstance();
 
-    _log->write(LogLevel::DEBUG, "GPIOEngineController ctor, _chip_path=%s, _engine_line_num=%d, _dir_line_num=%d, _pwm_period=%d, _rev_mode=%d\n",
+    LOG_DEBUG(_log, "GPIOEngineController ctor, _chip_path=%s, _engine_line_num=%d, _dir_line_num=%d, _pwm_period=%d, _rev_mode=%d\n",
             _chip_path.c_str(), _engine_line_num, _dir_line_num,
             _pwm_period, static_cast<int>(_rev_mode));
 
     if (config.syspwm_path != "")
     {
         // HW PWM mode
-        _pwm_thread = nullptr;
-        _syspwm_path = config.syspwm_path + "/pwm" + std::to_string(config.syspwm_num);
-        GPIOUtil::sysfs_write(config.syspwm_path + "/export", std::to_string(config.syspwm_num), _log);
+        _pwm_channel = nullptr;
+        _syspwm = new GPIOSysfsPWM(config.syspwm_path, config.syspwm_num);
     }
     else
     {
         // SW PWM mode
-        _pwm_thread = new GPIOPWMThread(_chip_path, _engine_line_num, _pwm_period);
+        _pwm_channel = new GPIOPWMChannel(_chip_path, _engine_line_num, _pwm_period, config.pwm_realtime);
     }
 
     if (_rev_mode == GPIOReverseMode::DEDICATED_LINE)
@@ -92,9 +91,13 @@ GPIOEngineController::GPIOEngineController(const GPIOEngineConfig &config) :
 GPIOEngineController::~GPIOEngineController()
 {
     Log::release();
-    if (_pwm_thread != nullptr)
+    if (_pwm_channel != nullptr)
     {
-        delete _pwm_thread;
+        delete _pwm_channel;
+    }
+    if (_syspwm != nullptr)
+    {
+        delete _syspwm;
     }
     if (_gpio_chip != nullptr)
     {
@@ -102,47 +105,39 @@ GPIOEngineController::~GPIOEngineController()
     }
 }
 
-void GPIOEngineController::set_steering(SteeringVal steering)
+void GPIOEngineController::set_steering_setpoint(Setpoint steering)
 {
     // N/A
 }
 
-SteeringVal GPIOEngineController::get_steering()
+Setpoint GPIOEngineController::get_steering_setpoint()
 {
-    return SteeringVal::STRAIGHT;
+    return 0;
 }
 
-void GPIOEngineController::set_speed(SpeedVal speed)
+void GPIOEngineController::set_speed_setpoint(Setpoint speed)
 {
-    _cur_speed = speed;
-    int int_speed = static_cast<int>(_cur_speed);
+    _cur_speed = clamp_setpoint(speed);
+    int int_speed = _cur_speed;
 
+    // duty cycles are calculated in thousandths of percent, so that
+    // the full setpoint resolution is passed to PWM
     switch (_rev_mode)
     {
         case GPIOReverseMode::SAME_LINE:
         {
-            unsigned int neutral = (_max_duty_cycle - _min_duty_cycle) / 2;
-            unsigned int step = (_max_duty_cycle - neutral) / 10;
-            int duty_cycle = neutral + step * int_speed;
-            if (duty_cycle < _min_duty_cycle)
+            long long neutral = (_max_duty_cycle - _min_duty_cycle) * 1000LL / 2;
+            long long duty_cycle = neutral + (_max_duty_cycle * 1000LL - neutral) * int_speed / SETPOINT_MAX;
+            if (duty_cycle < _min_duty_cycle * 1000LL)
             {
-                duty_cycle = _min_duty_cycle;
+                duty_cycle = _min_duty_cycle * 1000LL;
             }
-            else if (duty_cycle > _max_duty_cycle)
+            else if (duty_cycle > _max_duty_cycle * 1000LL)
             {
-                duty_cycle = _max_duty_cycle;
+                duty_cycle = _max_duty_cycle * 1000LL;
             }
 
-            unsigned int pwm_duration = duty_cycle * _pwm_period / 100;
-
-            if (_pwm_thread != nullptr)
-            {
-                _pwm_thread->set_pwm_duration(static_cast<unsigned int>(pwm_duration));
-            }
-            else
-            {
-                GPIOUtil::sysfs_write(_syspwm_path + "/duty_cycle", std::to_string(pwm_duration * 1000), _log);
-            }
+            set_duty_cycle(static_cast<unsigned long long>(duty_cycle));
             break;
         }
 
@@ -151,13 +146,13 @@ void GPIOEngineController::set_speed(SpeedVal speed)
             if (int_speed >= 0)
             {
                 _dir_line.set_value(1);
-                _log->write(LogLevel::DEBUG,
+                LOG_DEBUG(_log,
                         "GPIOEngineController, set direction line to 1\n");
             }
             else
             {
                 _dir_line.set_value(0);
-                _log->write(LogLevel::DEBUG,
+                LOG_DEBUG(_log,
                         "GPIOEngineController, set direction line to 0\n");
             }
             // fall through is intentional
@@ -166,57 +161,61 @@ void GPIOEngineController::set_speed(SpeedVal speed)
         case GPIOReverseMode::NO_REVERSE:
         {
             int_speed = std::abs(int_speed);
-            unsigned int duty_cycle = _min_duty_cycle + (int_speed * (_max_duty_cycle - _min_duty_cycle) / 10 );
-            unsigned int pwm_duration = duty_cycle * _pwm_period / 100;
-            if (_pwm_thread != nullptr)
-            {
-                _pwm_thread->set_pwm_duration(static_cast<unsigned int>(pwm_duration));
-            }
-            else
-            {
-                GPIOUtil::sysfs_write(_syspwm_path + "/duty_cycle", std::to_string(pwm_duration * 1000), _log);
-            }
-
+            unsigned long long duty_cycle = _min_duty_cycle * 1000ULL +
+                    static_cast<unsigned long long>(int_speed) * (_max_duty_cycle - _min_duty_cycle) * 1000ULL / SETPOINT_MAX;
+            set_duty_cycle(duty_cycle);
             break;
         }
     }
 
 }
 
-SpeedVal GPIOEngineController::get_speed()
+Setpoint GPIOEngineController::get_speed_setpoint()
 {
     return _cur_speed;
 }
 
+void GPIOEngineController::set_duty_cycle(unsigned long long duty_cycle)
+{
+    // PWM duration in nanoseconds
+    unsigned long long pwm_duration = duty_cycle * _pwm_period / 100;
+
+    if (_pwm_channel != nullptr)
+    {
+        _pwm_channel->set_pwm_duration(static_cast<unsigned int>(pwm_duration / 1000));
+    }
+    else
+    {
+        _syspwm->set_duty_cycle(pwm_duration);
+    }
+}
+
 void GPIOEngineController::start()
 {
-    if (_pwm_thread != nullptr)
+    if (_pwm_channel != nullptr)
     {
         // SW PWM mode
-        _pwm_thread->start();
+        _pwm_channel->start();
     }
     else
     {
         // HW PWM mode, set PWM period and duty cycle
         // Linux sysfs PWM API uses nanoseconds
-        GPIOUtil::sysfs_write(_syspwm_path + "/period", std::to_string(_pwm_period * 1000), _log);
         unsigned int pwm_duration = _min_duty_cycle * _pwm_period / 100;
-        GPIOUtil::sysfs_write(_syspwm_path + "/duty_cycle", std::to_string(pwm_duration * 1000), _log);
-        // enable HW PWM
-        GPIOUtil::sysfs_write(_syspwm_path + "/enable", std::string("1"), _log);
+        _syspwm->enable(_pwm_period * 1000ULL, pwm_duration * 1000ULL);
     }
 }
 
 void GPIOEngineController::stop()
 {
-    if (_pwm_thread != nullptr)
+    if (_pwm_channel != nullptr)
     {
-        _pwm_thread->stop();
+        _pwm_channel->stop();
     }
     else
     {
         // disable HW PWM
-        GPIOUtil::sysfs_write(_syspwm_path + "/enable", std::string("0"), _log);
+        _syspwm->disable();
     }
 }
 
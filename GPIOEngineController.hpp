@@ -28,7 +28,8 @@
 #include "ServoController.hpp"
 #include "Log.hpp"
 #include "GPIOEngineConfig.hpp"
-#include "GPIOPWMThread.hpp"
+#include "GPIOPWMScheduler.hpp"
+#include "GPIOUtil.hpp"
 
 namespace shipcontrol
 {
@@ -41,10 +42,11 @@ public:
     virtual ~GPIOEngineController();
 
     // ServoController implementation
-    virtual SpeedVal get_speed();
-    virtual void set_speed(SpeedVal speed);
-    virtual SteeringVal get_steering();
-    virtual void set_steering(SteeringVal steering);
+    virtual Setpoint get_speed_setpoint();
+    virtual void set_speed_setpoint(Setpoint speed);
+    virtual Setpoint get_steering_setpoint();
+    virtual void set_steering_setpoint(Setpoint steering);
+    virtual bool drives_steering() { return false; }
 
     virtual void start();
     virtual void stop();
@@ -63,18 +65,20 @@ protected:
     unsigned int _max_duty_cycle;
     GPIOReverseMode _rev_mode;
     // current engine speed
-    SpeedVal _cur_speed;
-    // full path to sysfs PWM line
-    // controller runs in HW PWM mode if this is not empty
-    std::string _syspwm_path;
+    Setpoint _cur_speed;
+    // sysfs PWM line
+    // controller runs in HW PWM mode if this is not null
+    GPIOSysfsPWM *_syspwm;
 
-    GPIOPWMThread *_pwm_thread;
+    GPIOPWMChannel *_pwm_channel;
 
     gpiod::chip *_gpio_chip;
     gpiod::line _dir_line;
 
     Log *_log;
 
+    // apply duty cycle given in thousandths of percent of PWM period
+    void set_duty_cycle(unsigned long long duty_cycle);
 };
 
 } // namespace shipcontrol
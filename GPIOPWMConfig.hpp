@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GPIOPWMCONFIG_HPP
+#define GPIOPWMCONFIG_HPP
+
+namespace shipcontrol
+{
+
+// scheduling settings of SW PWM threads
+struct GPIOPWMRealtimeConfig
+{
+    // SCHED_FIFO priority (1 - 99), 0 keeps the default scheduling policy
+    int priority = 0;
+    // CPU to pin SW PWM threads to, -1 means no pinning
+    int cpu = -1;
+    // lock process memory to avoid page faults in SW PWM loops
+    bool lock_memory = false;
+};
+
+} // namespace shipcontrol
+
+#endif // GPIOPWMCONFIG_HPP
@@ -0,0 +1,328 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <exception>
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <gpiod.hpp>
+
+#include "GPIOPWMScheduler.hpp"
+#include "Clock.hpp"
+
+namespace shipcontrol
+{
+
+std::mutex GPIOPWMScheduler::_instances_mutex;
+std::unordered_map<std::string, GPIOPWMScheduler *> GPIOPWMScheduler::_instances;
+
+GPIOPWMScheduler *GPIOPWMScheduler::getInstance(const std::string &chip_path, const GPIOPWMRealtimeConfig &rt_config)
+{
+    std::lock_guard<std::mutex> lock(_instances_mutex);
+
+    auto item = _instances.find(chip_path);
+    if (item != _instances.end())
+    {
+        item->second->_refs++;
+        return item->second;
+    }
+
+    GPIOPWMScheduler *scheduler = new GPIOPWMScheduler(chip_path, rt_config);
+    _instances[chip_path] = scheduler;
+    return scheduler;
+}
+
+void GPIOPWMScheduler::release(GPIOPWMScheduler *scheduler)
+{
+    std::lock_guard<std::mutex> lock(_instances_mutex);
+
+    scheduler->_refs--;
+    if (scheduler->_refs == 0)
+    {
+        _instances.erase(scheduler->_chip_path);
+        delete scheduler;
+    }
+}
+
+GPIOPWMScheduler::GPIOPWMScheduler(const std::string &chip_path, const GPIOPWMRealtimeConfig &rt_config) :
+    _chip_path(chip_path),
+    _rt_config(rt_config),
+    _refs(1),
+    _enabled_count(0),
+    _thread(nullptr),
+    _need_to_stop(false)
+{
+    _log = Log::getInstance();
+    LOG_DEBUG(_log, "GPIOPWMScheduler ctor, chip_path=%s\n", chip_path.c_str());
+
+    std::string labels = "chip=\"" + chip_path + "\"";
+    _jitter_metric = Metrics::summary("shipcontrol_pwm_jitter_ns",
+                                      "Lateness of S/W PWM edges in nanoseconds", labels);
+    _overruns_metric = Metrics::counter("shipcontrol_pwm_overruns_total",
+                                        "S/W PWM scheduler stalls longer than a PWM period", labels);
+}
+
+GPIOPWMScheduler::~GPIOPWMScheduler()
+{
+    stop_thread();
+    log_jitter_stats();
+    Log::release();
+}
+
+unsigned int GPIOPWMScheduler::add_line(unsigned int line_num, unsigned int pwm_period)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    LOG_DEBUG(_log, "GPIOPWMScheduler::add_line(), chip_path=%s, line=%d, pwm_period=%d\n",
+            _chip_path.c_str(), line_num, pwm_period);
+
+    // lines may be added to the timeline only while it isn't running
+    stop_thread();
+    _line_nums.push_back(line_num);
+    unsigned int index = _timeline.add_line(pwm_period);
+    if (_enabled_count > 0)
+    {
+        start_thread();
+    }
+    return index;
+}
+
+void GPIOPWMScheduler::enable_line(unsigned int index, bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_timeline.is_enabled(index) == enabled)
+    {
+        return;
+    }
+
+    // set of requested lines is fixed while the thread is running, so restart it
+    stop_thread();
+    _timeline.set_enabled(index, enabled);
+    if (enabled)
+    {
+        _enabled_count++;
+    }
+    else
+    {
+        _enabled_count--;
+    }
+    if (_enabled_count > 0)
+    {
+        start_thread();
+    }
+}
+
+void GPIOPWMScheduler::set_pwm_duration(unsigned int index, unsigned int pwm_duration)
+{
+    _timeline.set_duration(index, pwm_duration);
+    LOG_DEBUG(_log, "GPIOPWMScheduler::set_pwm_duration(%d), index=%d, new duration = %d\n",
+           pwm_duration, index, _timeline.get_duration(index));
+}
+
+void GPIOPWMScheduler::start_thread()
+{
+    _need_to_stop = false;
+    _thread = new std::thread(&GPIOPWMScheduler::run, this);
+}
+
+void GPIOPWMScheduler::stop_thread()
+{
+    if (_thread != nullptr)
+    {
+        // PWM loop never blocks for longer than a PWM period, so it can be joined
+        _need_to_stop = true;
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+}
+
+void GPIOPWMScheduler::run()
+{
+    LOG_DEBUG(_log, "GPIOPWMScheduler::run(), chip_path=%s\n", _chip_path.c_str());
+
+    setup_realtime();
+
+    try
+    {
+        // request enabled lines only
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> indices;
+        for (unsigned int i = 0; i < _timeline.size(); i++)
+        {
+            if (_timeline.is_enabled(i))
+            {
+                offsets.push_back(_line_nums[i]);
+                indices.push_back(i);
+            }
+        }
+
+        gpiod::chip chip(_chip_path);
+        gpiod::line_bulk lines = chip.get_lines(offsets);
+        lines.request({"shipcontrol::GPIOPWMScheduler",
+                gpiod::line_request::DIRECTION_OUTPUT,
+                0},
+                std::vector<int>(offsets.size(), 0));
+
+        std::vector<int> values(_timeline.size(), 0);
+        std::vector<int> line_values(offsets.size(), 0);
+        long long max_lateness = _timeline.get_min_period();
+
+        _timeline.reset(monotonic_now());
+
+        while ((_need_to_stop == false) && (_timeline.is_empty() == false))
+        {
+            long long deadline = _timeline.next_edge_time();
+            timespec ts;
+            ts.tv_sec = deadline / 1000000000LL;
+            ts.tv_nsec = deadline % 1000000000LL;
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+            {
+            }
+
+            long long now = monotonic_now();
+            long long lateness = now - deadline;
+            std::uint64_t jitter = (lateness > 0) ? static_cast<std::uint64_t>(lateness) : 0;
+            _jitter.record(jitter);
+            _jitter_metric->record(jitter);
+
+            // all edges due at this time are applied with a single request
+            _timeline.pop_edges(values);
+            for (unsigned int i = 0; i < indices.size(); i++)
+            {
+                line_values[i] = values[indices[i]];
+            }
+            lines.set_values(line_values);
+
+            if (lateness > max_lateness)
+            {
+                _overruns_metric->inc();
+                // don't try to catch up if the thread has been stalled for more than a period
+                _timeline.reset(monotonic_now());
+            }
+        }
+
+        lines.set_values(std::vector<int>(offsets.size(), 0));
+        lines.release();
+    }
+    catch (const std::exception &e)
+    {
+        _log->write(LogLevel::ERROR, "GPIOPWMScheduler caught exception: %s\n", e.what());
+    }
+
+    LOG_DEBUG(_log, "GPIOPWMScheduler stopping\n");
+}
+
+void GPIOPWMScheduler::setup_realtime()
+{
+    if (_rt_config.lock_memory)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            _log->write(LogLevel::NOTICE, "GPIOPWMScheduler failed to lock memory, error code %d\n", errno);
+        }
+    }
+
+    if (_rt_config.cpu >= 0)
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(_rt_config.cpu, &cpuset);
+        int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        if (ret != 0)
+        {
+            _log->write(LogLevel::NOTICE, "GPIOPWMScheduler failed to set CPU affinity to %d, error code %d\n",
+                        _rt_config.cpu, ret);
+        }
+    }
+
+    if (_rt_config.priority > 0)
+    {
+        sched_param param;
+        param.sched_priority = _rt_config.priority;
+        int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (ret != 0)
+        {
+            _log->write(LogLevel::NOTICE, "GPIOPWMScheduler failed to set SCHED_FIFO priority %d, error code %d\n",
+                        _rt_config.priority, ret);
+        }
+    }
+}
+
+void GPIOPWMScheduler::log_jitter_stats()
+{
+    if (_jitter.get_count() == 0)
+    {
+        return;
+    }
+
+    _log->write(LogLevel::NOTICE,
+                "GPIOPWMScheduler %s: %llu edges, lateness p50 %llu ns, p99 %llu ns, max %llu ns\n",
+                _chip_path.c_str(),
+                static_cast<unsigned long long>(_jitter.get_count()),
+                static_cast<unsigned long long>(_jitter.get_percentile(0.5)),
+                static_cast<unsigned long long>(_jitter.get_percentile(0.99)),
+                static_cast<unsigned long long>(_jitter.get_max()));
+}
+
+GPIOPWMChannel::GPIOPWMChannel(const std::string &chip_path,
+                               unsigned int line_num,
+                               unsigned int pwm_period,
+                               const GPIOPWMRealtimeConfig &rt_config) :
+    _started(false)
+{
+    _scheduler = GPIOPWMScheduler::getInstance(chip_path, rt_config);
+    _index = _scheduler->add_line(line_num, pwm_period);
+}
+
+GPIOPWMChannel::~GPIOPWMChannel()
+{
+    stop();
+    GPIOPWMScheduler::release(_scheduler);
+}
+
+void GPIOPWMChannel::start()
+{
+    if (_started == false)
+    {
+        _scheduler->enable_line(_index, true);
+        _started = true;
+    }
+}
+
+void GPIOPWMChannel::stop()
+{
+    if (_started == true)
+    {
+        _scheduler->enable_line(_index, false);
+        _started = false;
+    }
+}
+
+void GPIOPWMChannel::set_pwm_duration(unsigned int pwm_duration)
+{
+    _scheduler->set_pwm_duration(_index, pwm_duration);
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GPIOPWMSCHEDULER_HPP
+#define GPIOPWMSCHEDULER_HPP
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Log.hpp"
+#include "GPIOPWMConfig.hpp"
+#include "GPIOPWMTimeline.hpp"
+#include "LatencyHistogram.hpp"
+#include "Metrics.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Software PWM scheduler, which drives all SW PWM lines of a single GPIO chip
+ * from one thread.
+ * Edges of all lines are merged into a single timeline, lines changing at the
+ * same time are set with a single bulk request. Edges are scheduled on absolute
+ * CLOCK_MONOTONIC deadlines, lateness of every edge is recorded in jitter
+ * statistics.
+ * There is one scheduler per chip, shared through getInstance()/release().
+ */
+class GPIOPWMScheduler
+{
+public:
+    static GPIOPWMScheduler *getInstance(const std::string &chip_path, const GPIOPWMRealtimeConfig &rt_config);
+    static void release(GPIOPWMScheduler *scheduler);
+
+    // register line, returns line index used by other methods;
+    // a running scheduler thread is restarted to pick up the new line
+    unsigned int add_line(unsigned int line_num, unsigned int pwm_period);
+    // the scheduler thread runs while at least one line is enabled
+    void enable_line(unsigned int index, bool enabled);
+    void set_pwm_duration(unsigned int index, unsigned int pwm_duration);
+
+    // lateness of pulse edges in nanoseconds
+    const LatencyHistogram &get_jitter_stats() { return _jitter; }
+
+protected:
+    GPIOPWMScheduler(const std::string &chip_path, const GPIOPWMRealtimeConfig &rt_config);
+    virtual ~GPIOPWMScheduler();
+
+    void run();
+    void start_thread();
+    void stop_thread();
+    // apply scheduling settings to the calling thread
+    void setup_realtime();
+    void log_jitter_stats();
+
+    static std::mutex _instances_mutex;
+    static std::unordered_map<std::string, GPIOPWMScheduler *> _instances;
+
+    const std::string _chip_path;
+    const GPIOPWMRealtimeConfig _rt_config;
+    unsigned int _refs;
+    // protects lines configuration and thread state
+    std::mutex _mutex;
+    GPIOPWMTimeline _timeline;
+    std::vector<unsigned int> _line_nums;
+    unsigned int _enabled_count;
+    std::thread *_thread;
+    std::atomic<bool> _need_to_stop;
+    LatencyHistogram _jitter;
+    // exported jitter and overruns of the chip
+    Metric *_jitter_metric;
+    Metric *_overruns_metric;
+    Log *_log;
+};
+
+// single SW PWM line driven by GPIOPWMScheduler of its chip
+class GPIOPWMChannel
+{
+public:
+    GPIOPWMChannel(const std::string &chip_path,
+                   unsigned int line_num,
+                   unsigned int pwm_period,
+                   const GPIOPWMRealtimeConfig &rt_config = GPIOPWMRealtimeConfig());
+    GPIOPWMChannel(const GPIOPWMChannel &other) = delete;
+    virtual ~GPIOPWMChannel();
+
+    void start();
+    void stop();
+    // PWM duration in microseconds
+    void set_pwm_duration(unsigned int pwm_duration);
+
+protected:
+    GPIOPWMScheduler *_scheduler;
+    unsigned int _index;
+    bool _started;
+};
+
+} // namespace shipcontrol
+
+#endif // GPIOPWMSCHEDULER_HPP
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GPIOPWMTimeline.hpp"
+
+namespace shipcontrol
+{
+
+unsigned int GPIOPWMTimeline::add_line(unsigned int period_us)
+{
+    _lines.emplace_back();
+    Line &line = _lines.back();
+    line.period = period_us * 1000LL;
+    line.duration_us.store(0, std::memory_order_relaxed);
+    line.enabled = false;
+    return _lines.size() - 1;
+}
+
+void GPIOPWMTimeline::set_enabled(unsigned int index, bool enabled)
+{
+    _lines[index].enabled = enabled;
+}
+
+void GPIOPWMTimeline::set_duration(unsigned int index, unsigned int duration_us)
+{
+    Line &line = _lines[index];
+    long long period_us = line.period / 1000;
+    if ((period_us > 0) && (duration_us >= period_us))
+    {
+        duration_us = period_us - 1;
+    }
+    line.duration_us.store(duration_us, std::memory_order_relaxed);
+}
+
+unsigned int GPIOPWMTimeline::get_duration(unsigned int index) const
+{
+    return _lines[index].duration_us.load(std::memory_order_relaxed);
+}
+
+void GPIOPWMTimeline::reset(long long start)
+{
+    _edges = std::priority_queue<Edge, std::vector<Edge>, EdgeLater>();
+    for (unsigned int i = 0; i < _lines.size(); i++)
+    {
+        if (_lines[i].enabled && (_lines[i].period > 0))
+        {
+            _edges.push(Edge{start, i, true});
+        }
+    }
+}
+
+long long GPIOPWMTimeline::pop_edges(std::vector<int> &values)
+{
+    long long time = _edges.top().time;
+
+    while ((_edges.empty() == false) && (_edges.top().time == time))
+    {
+        Edge edge = _edges.top();
+        _edges.pop();
+        Line &line = _lines[edge.index];
+
+        if (edge.rising)
+        {
+            unsigned int duration = line.duration_us.load(std::memory_order_relaxed);
+            _edges.push(Edge{time + line.period, edge.index, true});
+            if (duration != 0)
+            {
+                values[edge.index] = 1;
+                _edges.push(Edge{time + duration * 1000LL, edge.index, false});
+            }
+            else
+            {
+                values[edge.index] = 0;
+            }
+        }
+        else
+        {
+            values[edge.index] = 0;
+        }
+    }
+
+    return time;
+}
+
+long long GPIOPWMTimeline::get_min_period() const
+{
+    long long min_period = 0;
+    for (const Line &line : _lines)
+    {
+        if (line.enabled && (line.period > 0) && ((min_period == 0) || (line.period < min_period)))
+        {
+            min_period = line.period;
+        }
+    }
+    return min_period;
+}
+
+} // namespace shipcontrol
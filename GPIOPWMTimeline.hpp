@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GPIOPWMTIMELINE_HPP
+#define GPIOPWMTIMELINE_HPP
+
+#include <atomic>
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace shipcontrol
+{
+
+/*
+ * Merged edge timeline of several SW PWM lines.
+ * Pending edges of all lines are kept in a min-heap ordered by time, all
+ * edges falling on the same time are applied together, so that they can be
+ * written to GPIO in a single request. All lines start their periods at the
+ * same time, so rising edges of lines with equal periods stay aligned.
+ *
+ * Lines may be added and enabled only while the timeline isn't running,
+ * PWM duration may be changed at any time from any thread.
+ * Times are in nanoseconds.
+ */
+class GPIOPWMTimeline
+{
+public:
+    // returns index of the new line
+    unsigned int add_line(unsigned int period_us);
+    void set_enabled(unsigned int index, bool enabled);
+    bool is_enabled(unsigned int index) const { return _lines[index].enabled; }
+    // PWM duration in microseconds, clamped to the line's period
+    void set_duration(unsigned int index, unsigned int duration_us);
+    unsigned int get_duration(unsigned int index) const;
+    unsigned int size() const { return _lines.size(); }
+
+    // schedule first periods of all enabled lines at start time
+    void reset(long long start);
+    bool is_empty() const { return _edges.empty(); }
+    long long next_edge_time() const { return _edges.top().time; }
+    // apply all edges at the earliest time to line values, returns time of the edges
+    long long pop_edges(std::vector<int> &values);
+    // shortest period of enabled lines
+    long long get_min_period() const;
+
+protected:
+    struct Line
+    {
+        long long period;
+        std::atomic<unsigned int> duration_us;
+        bool enabled;
+    };
+
+    struct Edge
+    {
+        long long time;
+        unsigned int index;
+        bool rising;
+    };
+
+    struct EdgeLater
+    {
+        bool operator()(const Edge &a, const Edge &b) const { return a.time > b.time; }
+    };
+
+    // deque keeps lines in place, since they contain atomics
+    std::deque<Line> _lines;
+    std::priority_queue<Edge, std::vector<Edge>, EdgeLater> _edges;
+};
+
+} // namespace shipcontrol
+
+#endif // GPIOPWMTIMELINE_HPP
@@ -23,6 +23,8 @@
 
 #include <string>
 
+#include "GPIOPWMConfig.hpp"
+
 namespace shipcontrol
 {
 
@@ -41,6 +43,8 @@ struct GPIOSteeringConfig
     // min and max duty cycle are in % of pwm_period
     unsigned int min_duty_cycle = 10;
     unsigned int max_duty_cycle = 20;
+    // SW PWM thread scheduling, shared by all SW PWM lines
+    GPIOPWMRealtimeConfig pwm_realtime;
 };
 
 }
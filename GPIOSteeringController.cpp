@@ -19,14 +19,14 @@
  */
 
 #include "GPIOSteeringController.hpp"
-#include "GPIOUtil.hpp"
 
 namespace shipcontrol
 {
 
 GPIOSteeringController::GPIOSteeringController(const GPIOSteeringConfig &config) :
-_cur_steering(SteeringVal::STRAIGHT),
-_pwm_thread(nullptr)
+_cur_steering(0),
+_pwm_channel(nullptr),
+_syspwm(nullptr)
 {
     _chip_path = config.chip_path;
     _steering_line = config.steering_line;
@@ -39,13 +39,12 @@ _pwm_thread(nullptr)
     if (config.syspwm_path.empty())
     {
         // S/W PWM mode
-        _pwm_thread = new GPIOPWMThread(_chip_path, _steering_line, _pwm_period);
+        _pwm_channel = new GPIOPWMChannel(_chip_path, _steering_line, _pwm_period, config.pwm_realtime);
     }
     else
     {
         // H/W PWM mode
-        _pwm_path = config.syspwm_path + "/pwm" + std::to_string(config.syspwm_num);
-        GPIOUtil::sysfs_write(config.syspwm_path + "/export", std::to_string(config.syspwm_num), _log);
+        _syspwm = new GPIOSysfsPWM(config.syspwm_path, config.syspwm_num);
     }
 }
 
@@ -53,59 +52,56 @@ GPIOSteeringController::~GPIOSteeringController()
 {
     Log::release();
 
-    delete _pwm_thread;
+    delete _pwm_channel;
+    delete _syspwm;
 }
 
 void GPIOSteeringController::start()
 {
-    if (_pwm_thread != nullptr)
+    if (_pwm_channel != nullptr)
     {
-        _pwm_thread->start();
+        _pwm_channel->start();
     }
     else
     {
         // HW PWM mode, set PWM period and duty cycle
         // Linux sysfs PWM API uses nanoseconds
-        GPIOUtil::sysfs_write(_pwm_path + "/period", std::to_string(_pwm_period * 1000), _log);
         unsigned int straight = (_min_duty_cycle + _max_duty_cycle) / 2;
         unsigned int pwm_duration = straight * _pwm_period / 100;
-        GPIOUtil::sysfs_write(_pwm_path + "/duty_cycle", std::to_string(pwm_duration * 1000), _log);
-        // enable HW PWM
-        GPIOUtil::sysfs_write(_pwm_path + "/enable", std::string("1"), _log);
+        _syspwm->enable(_pwm_period * 1000ULL, pwm_duration * 1000ULL);
     }
 }
 
 void GPIOSteeringController::stop()
 {
-    if (_pwm_thread != nullptr)
+    if (_pwm_channel != nullptr)
     {
-        _pwm_thread->stop();
+        _pwm_channel->stop();
     }
     else
     {
-        GPIOUtil::sysfs_write(_pwm_path + "/enable", std::string("0"), _log);
+        _syspwm->disable();
     }
 }
 
-void GPIOSteeringController::set_steering(SteeringVal steering)
+void GPIOSteeringController::set_steering_setpoint(Setpoint steering)
 {
-    _cur_steering = steering;
-    int int_steering = static_cast<int>(steering);
-    // multiply duty cycle percentages by 10 to increase setting accuracy
-    unsigned int min_duty_cycle = _min_duty_cycle * 10;
-    unsigned int max_duty_cycle = _max_duty_cycle * 10;
-    unsigned int straight = (min_duty_cycle + max_duty_cycle) / 2;
-    unsigned int duty_cycle = straight + int_steering * (max_duty_cycle - straight) / 10;
-    // divide by 1000 instead of 100 because we multiplied percentages by 10 earlier
-    unsigned int pwm_duration = duty_cycle * _pwm_period / 1000;
-    if (_pwm_thread != nullptr)
+    _cur_steering = clamp_setpoint(steering);
+    // duty cycles in thousandths of percent to keep the full setpoint resolution
+    long long min_duty_cycle = _min_duty_cycle * 1000LL;
+    long long max_duty_cycle = _max_duty_cycle * 1000LL;
+    long long straight = (min_duty_cycle + max_duty_cycle) / 2;
+    long long duty_cycle = straight + _cur_steering * (max_duty_cycle - straight) / SETPOINT_MAX;
+    // PWM duration in nanoseconds
+    unsigned long long pwm_duration = static_cast<unsigned long long>(duty_cycle) * _pwm_period / 100;
+    if (_pwm_channel != nullptr)
     {
-        _pwm_thread->set_pwm_duration(pwm_duration);
+        _pwm_channel->set_pwm_duration(static_cast<unsigned int>(pwm_duration / 1000));
     }
     else
     {
-        GPIOUtil::sysfs_write(_pwm_path + "/duty_cycle", std::to_string(pwm_duration * 1000), _log);
+        _syspwm->set_duty_cycle(pwm_duration);
     }
 }
 
-}
\ No newline at end of file
+}
@@ -23,7 +23,8 @@
 
 #include "ServoController.hpp"
 #include "GPIOSteeringConfig.hpp"
-#include "GPIOPWMThread.hpp"
+#include "GPIOPWMScheduler.hpp"
+#include "GPIOUtil.hpp"
 #include "Log.hpp"
 
 namespace shipcontrol
@@ -36,10 +37,11 @@ public:
     virtual ~GPIOSteeringController();
 
     // ServoController implementation
-    virtual SpeedVal get_speed() { return SpeedVal::STOP; }
-    virtual void set_speed(SpeedVal speed) { /* N/A*/ }
-    virtual SteeringVal get_steering() { return _cur_steering; }
-    virtual void set_steering(SteeringVal steering);
+    virtual Setpoint get_speed_setpoint() { return 0; }
+    virtual void set_speed_setpoint(Setpoint speed) { /* N/A*/ }
+    virtual Setpoint get_steering_setpoint() { return _cur_steering; }
+    virtual void set_steering_setpoint(Setpoint steering);
+    virtual bool drives_speed() { return false; }
 
     virtual void start();
     virtual void stop();
@@ -47,15 +49,16 @@ public:
 protected:
     std::string _chip_path;
     unsigned int _steering_line;
-    std::string _pwm_path;
     unsigned int _pwm_period;
     unsigned int _min_duty_cycle;
     unsigned int _max_duty_cycle;
-    SteeringVal _cur_steering;
+    Setpoint _cur_steering;
 
     Log *_log;
 
-    GPIOPWMThread *_pwm_thread;
+    GPIOPWMChannel *_pwm_channel;
+    // H/W PWM line, used if sysfs PWM is configured
+    GPIOSysfsPWM *_syspwm;
 };
 
 }
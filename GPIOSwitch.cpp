@@ -32,7 +32,7 @@ GPIOSwitch::GPIOSwitch(const std::string &chip_path, unsigned int line_num) :
     _ok(false)
 {
     _log = Log::getInstance();
-    _log->write(LogLevel::DEBUG, "GPIOSwitch ctor, chip_path=%s, line_num=%d\n",
+    LOG_DEBUG(_log, "GPIOSwitch ctor, chip_path=%s, line_num=%d\n",
             chip_path.c_str(), line_num);
 
     try
@@ -72,13 +72,13 @@ GPIOSwitch::~GPIOSwitch()
 
 void GPIOSwitch::on()
 {
-    _log->write(LogLevel::DEBUG, "GPIOSwitch line %d ON", _line_num);
+    LOG_DEBUG(_log, "GPIOSwitch line %d ON", _line_num);
     _line.set_value(1);
 }
 
 void GPIOSwitch::off()
 {
-    _log->write(LogLevel::DEBUG, "GPIOSwitch line %d OFF", _line_num);
+    LOG_DEBUG(_log, "GPIOSwitch line %d OFF", _line_num);
     _line.set_value(0);
 }
 
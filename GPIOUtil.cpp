@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2024 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,23 +19,31 @@
  */
 
 #include "GPIOUtil.hpp"
+#include "Metrics.hpp"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#include <charconv>
 
 namespace shipcontrol
 {
 
+// failed opens count as well, they make the write impossible
+static Metric *sysfs_write_errors = Metrics::counter("shipcontrol_sysfs_write_errors_total",
+                                                     "Failed writes to sysfs GPIO and PWM files");
+
 void GPIOUtil::sysfs_write(const std::string &path, const std::string &value, Log *log)
 {
-    log->write(LogLevel::DEBUG, "GPIOEngineController::sysfs_write(), path=%s, value=%s\n",
+    LOG_DEBUG(log, "GPIOEngineController::sysfs_write(), path=%s, value=%s\n",
             path.c_str(), value.c_str());
 
     int fd = open(path.c_str(), O_WRONLY);
 
     if (fd == -1)
     {
+        sysfs_write_errors->inc();
         log->write(LogLevel::ERROR,
                 "GPIOEngineController failed to open file %s, errno=%d\n",
                 path.c_str(), errno);
@@ -45,6 +53,7 @@ void GPIOUtil::sysfs_write(const std::string &path, const std::string &value, Lo
     ssize_t written = write(fd, reinterpret_cast<const void*>(value.c_str()), value.size());
     if (written != value.size())
     {
+        sysfs_write_errors->inc();
         log->write(LogLevel::ERROR,
                 "GPIOEngineController write to %s, expected to write %d bytes, wrote %d instead, errno=%d\n",
                 path.c_str(), value.size(), written, errno);
@@ -52,4 +61,111 @@ void GPIOUtil::sysfs_write(const std::string &path, const std::string &value, Lo
 
     close(fd);
 }
-}
\ No newline at end of file
+
+GPIOSysfsPWM::GPIOSysfsPWM(const std::string &syspwm_path, unsigned int num) :
+    _path(syspwm_path + "/pwm" + std::to_string(num)),
+    _period_fd(-1),
+    _duty_cycle_fd(-1),
+    _enable_fd(-1)
+{
+    _log = Log::getInstance();
+    GPIOUtil::sysfs_write(syspwm_path + "/export", std::to_string(num), _log);
+}
+
+GPIOSysfsPWM::~GPIOSysfsPWM()
+{
+    if (_period_fd != -1)
+    {
+        close(_period_fd);
+    }
+    if (_duty_cycle_fd != -1)
+    {
+        close(_duty_cycle_fd);
+    }
+    if (_enable_fd != -1)
+    {
+        close(_enable_fd);
+    }
+    Log::release();
+}
+
+bool GPIOSysfsPWM::open_files()
+{
+    const char *names[] = { "/period", "/duty_cycle", "/enable" };
+    int *fds[] = { &_period_fd, &_duty_cycle_fd, &_enable_fd };
+
+    bool ok = true;
+    for (int i = 0; i < 3; i++)
+    {
+        if (*fds[i] == -1)
+        {
+            std::string path = _path + names[i];
+            *fds[i] = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+            if (*fds[i] == -1)
+            {
+                sysfs_write_errors->inc();
+                _log->write(LogLevel::ERROR,
+                        "GPIOSysfsPWM failed to open file %s, errno=%d\n",
+                        path.c_str(), errno);
+                ok = false;
+            }
+        }
+    }
+
+    return ok;
+}
+
+void GPIOSysfsPWM::write_value(int fd, unsigned long long value, const char *name)
+{
+    if (fd == -1)
+    {
+        return;
+    }
+
+    // newline-terminated like echo writes it, sysfs accepts it and readers of
+    // a simulated tree stop at the newline, ignoring bytes of a longer previous value
+    char buf[24];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf) - 1, value);
+    *res.ptr = '\n';
+    std::size_t len = res.ptr + 1 - buf;
+
+    ssize_t written = pwrite(fd, buf, len, 0);
+    if (written != static_cast<ssize_t>(len))
+    {
+        sysfs_write_errors->inc();
+        _log->write(LogLevel::ERROR,
+                "GPIOSysfsPWM write to %s/%s, expected to write %d bytes, wrote %d instead, errno=%d\n",
+                _path.c_str(), name, static_cast<int>(len), static_cast<int>(written), errno);
+    }
+}
+
+void GPIOSysfsPWM::enable(unsigned long long period, unsigned long long duty_cycle)
+{
+    LOG_DEBUG(_log, "GPIOSysfsPWM::enable(), path=%s, period=%llu, duty_cycle=%llu\n",
+            _path.c_str(), period, duty_cycle);
+
+    open_files();
+    write_value(_period_fd, period, "period");
+    write_value(_duty_cycle_fd, duty_cycle, "duty_cycle");
+    write_value(_enable_fd, 1, "enable");
+}
+
+void GPIOSysfsPWM::disable()
+{
+    write_value(_enable_fd, 0, "enable");
+}
+
+void GPIOSysfsPWM::set_duty_cycle(unsigned long long duty_cycle)
+{
+    if (_duty_cycle_fd == -1)
+    {
+        // not enabled yet
+        if (open_files() == false)
+        {
+            return;
+        }
+    }
+    write_value(_duty_cycle_fd, duty_cycle, "duty_cycle");
+}
+
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2024 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -33,6 +33,38 @@ public:
     static void sysfs_write(const std::string &path, const std::string &value, Log *log);
 };
 
+/*
+ * Linux sysfs H/W PWM channel.
+ * period, duty_cycle and enable files are opened once and kept open, values
+ * are formatted on stack with a trailing newline and written with a single
+ * pwrite(), so that duty cycle updates don't allocate and cost one syscall each.
+ * All values are in nanoseconds.
+ */
+class GPIOSysfsPWM
+{
+public:
+    // exports PWM channel num of the PWM chip at syspwm_path
+    GPIOSysfsPWM(const std::string &syspwm_path, unsigned int num);
+    GPIOSysfsPWM(const GPIOSysfsPWM &other) = delete;
+    virtual ~GPIOSysfsPWM();
+
+    // set period and initial duty cycle and enable PWM output
+    void enable(unsigned long long period, unsigned long long duty_cycle);
+    void disable();
+    void set_duty_cycle(unsigned long long duty_cycle);
+
+protected:
+    // sysfs files are created asynchronously after export, so they're opened on first use
+    bool open_files();
+    void write_value(int fd, unsigned long long value, const char *name);
+
+    std::string _path;
+    int _period_fd;
+    int _duty_cycle_fd;
+    int _enable_fd;
+    Log *_log;
+};
+
 }
 
 #endif // GPIOUTIL_HPP
\ No newline at end of file
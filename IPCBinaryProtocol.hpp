@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IPCBINARYPROTOCOL_HPP
+#define IPCBINARYPROTOCOL_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+namespace shipcontrol
+{
+
+/*
+ * Compact binary IPC protocol for high-rate clients.
+ *
+ * A connection switches to the binary protocol if the first byte it sends is
+ * IPC_BINARY_MAGIC, otherwise JSON requests are expected. In binary mode the
+ * client sends fixed-size IPCBinaryRequest records and gets one IPCBinaryReply
+ * per request, in the same order. Every record starts with IPC_BINARY_MAGIC,
+ * a record with a wrong magic closes the connection.
+ * Fields are in host byte order, the peer is always on the same machine.
+ *
+ * Speed and steering values are in per-mille of maximum, positive values
+ * mean forward and right, negative ones reverse and left.
+ */
+
+#define IPC_BINARY_MAGIC    0xB5
+
+enum class IPCBinaryOpcode : std::uint8_t
+{
+    QUERY = 0,
+    SPEED_UP,
+    SPEED_DOWN,
+    TURN_LEFT,
+    TURN_RIGHT,
+    // value: target speed
+    SET_SPEED,
+    // value: target steering
+    SET_STEERING
+};
+
+enum class IPCBinaryStatus : std::uint8_t
+{
+    OK = 0,
+    FAIL
+};
+
+struct IPCBinaryRequest
+{
+    std::uint8_t magic;
+    // IPCBinaryOpcode
+    std::uint8_t opcode;
+    std::int16_t value;
+    // echoed back in reply
+    std::uint32_t seq;
+    // client timestamp, echoed back in reply
+    std::uint64_t timestamp;
+};
+
+struct IPCBinaryReply
+{
+    std::uint8_t magic;
+    // IPCBinaryStatus
+    std::uint8_t status;
+    // current ship status
+    std::int16_t speed;
+    std::int16_t steering;
+    std::uint16_t reserved;
+    std::uint32_t seq;
+    std::uint32_t reserved2;
+    std::uint64_t timestamp;
+};
+
+static_assert(sizeof(IPCBinaryRequest) == 16, "unexpected IPCBinaryRequest layout");
+static_assert(sizeof(IPCBinaryReply) == 24, "unexpected IPCBinaryReply layout");
+static_assert(std::is_trivially_copyable<IPCBinaryRequest>::value, "IPCBinaryRequest must be trivially copyable");
+static_assert(std::is_trivially_copyable<IPCBinaryReply>::value, "IPCBinaryReply must be trivially copyable");
+
+} // namespace shipcontrol
+
+#endif // IPCBINARYPROTOCOL_HPP
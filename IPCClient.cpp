@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2018 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,69 +19,153 @@
  */
 
 #include "IPCClient.hpp"
+#include "Clock.hpp"
+#include <sys/types.h>
+#include <sys/socket.h>
 #include <unistd.h>
+#include <cerrno>
+#include <cstring>
 
 namespace shipcontrol
 {
 
-IPCClient::IPCClient(int fd, IPCRequestHandler &handler)
+IPCClient::IPCClient(int fd, IPCRequestHandler &handler, IPCBuffers *buffers)
 : _fd(fd),
+  _protocol(IPCProtocol::UNKNOWN),
+  _buffers(buffers),
+  _out_pos(0),
+  _epoll_events(0),
   _rq_handler(handler)
 {
-    _buf = static_cast<unsigned char *>(new unsigned char[BUFSIZE]);
+    _buffers->in.reset();
+    _buffers->out.clear();
     _log = Log::getInstance();
 }
 
 IPCClient::~IPCClient()
 {
     Log::release();
-    delete _buf;
+    if (_fd != -1)
+    {
+        close(_fd);
+    }
 }
 
-void IPCClient::run()
+bool IPCClient::on_readable()
 {
-    if (_fd == -1)
+    // read available data, pass every complete request to IPCRequestHandler and queue the responses
+    IPCMessageFramer &framer = _buffers->in;
+    ssize_t len = read(_fd, framer.get_write_ptr(BUFSIZE), BUFSIZE);
+    if (len == -1)
     {
-        return;
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))
+        {
+            return true;
+        }
+        _log->write(LogLevel::NOTICE, "IPCClient failed to read data from socket, error code %d\n", errno);
+        return false;
     }
+    if (len == 0)
+    {
+        // peer has closed the connection, incomplete request is dropped
+        return false;
+    }
+    framer.commit(len);
+    long long received = monotonic_now();
 
-    while (true)
+    if (_protocol == IPCProtocol::UNKNOWN)
     {
-        if (need_to_stop() == true)
-        {
-            break;
-        }
+        _protocol = (static_cast<unsigned char>(framer.get_pending()[0]) == IPC_BINARY_MAGIC) ?
+                    IPCProtocol::BINARY : IPCProtocol::JSON;
+    }
 
-        // read request, pass it to IPCRequestHandler for processing and send back the response
-        int len = read(_fd, reinterpret_cast<void *>(_buf), BUFSIZE);
-        if (len == -1)
+    bool ok = (_protocol == IPCProtocol::BINARY) ? handle_binary(received) : handle_json(received);
+
+    // queued responses are sent even if the connection is going to be closed
+    return on_writable() && ok;
+}
+
+bool IPCClient::handle_json(long long received)
+{
+    IPCMessageFramer &framer = _buffers->in;
+
+    // responses are queued in the order of requests, so pipelining clients can match them
+    std::string_view request;
+    while (framer.next(request))
+    {
+        _buffers->out += _rq_handler.handleRequest(request, received);
+        _buffers->out += '\n';
+    }
+
+    if (framer.is_overflow())
+    {
+        _log->write(LogLevel::NOTICE, "IPCClient request exceeds %d bytes, closing connection\n", IPC_MAX_MESSAGE_SIZE);
+        return false;
+    }
+
+    return true;
+}
+
+bool IPCClient::handle_binary(long long received)
+{
+    IPCMessageFramer &framer = _buffers->in;
+    IPCBinaryRequest request;
+    IPCBinaryReply reply;
+
+    std::string_view pending = framer.get_pending();
+    while (pending.size() >= sizeof(IPCBinaryRequest))
+    {
+        std::memcpy(&request, pending.data(), sizeof(IPCBinaryRequest));
+        framer.consume(sizeof(IPCBinaryRequest));
+        pending.remove_prefix(sizeof(IPCBinaryRequest));
+
+        if (request.magic != IPC_BINARY_MAGIC)
         {
-            _log->write(LogLevel::NOTICE, "IPCClient failed to read data from socket, error code %d\n", errno);
-            break;
+            _log->write(LogLevel::NOTICE, "IPCClient received invalid binary request, closing connection\n");
+            return false;
         }
-        _buf[len] = '\0';
-        std::string resp = _rq_handler.handleRequest(std::string(reinterpret_cast<char *>(_buf)));
 
-        if (write(_fd, reinterpret_cast<const void *>(resp.c_str()), resp.length()) == -1)
+        _rq_handler.handleRequest(request, reply, received);
+        _buffers->out.append(reinterpret_cast<const char *>(&reply), sizeof(IPCBinaryReply));
+    }
+
+    return true;
+}
+
+bool IPCClient::on_writable()
+{
+    while (has_pending_output())
+    {
+        ssize_t len = send(_fd, _buffers->out.data() + _out_pos,
+                           _buffers->out.size() - _out_pos, MSG_NOSIGNAL);
+        if (len == -1)
         {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                // socket buffer is full, wait for the next notification
+                return true;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
             _log->write(LogLevel::NOTICE, "IPCClient failed to write data into socket, error code %d\n", errno);
-            break;
+            return false;
         }
+        _out_pos += len;
     }
-}
 
-void IPCClient::stop()
-{
-    teardown();
-    SingleThread::stop();
+    _buffers->out.clear();
+    _out_pos = 0;
+
+    return true;
 }
 
-void IPCClient::teardown()
+IPCBuffers *IPCClient::release_buffers()
 {
-    if (_fd != -1)
-    {
-        close(_fd);
-    }
+    IPCBuffers *buffers = _buffers;
+    _buffers = nullptr;
+    return buffers;
 }
 
 } // namespace shipcontrol
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2018 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -21,29 +21,71 @@
 #ifndef IPCCLIENT_HPP
 #define IPCCLIENT_HPP
 
-#include "SingleThread.hpp"
 #include "Log.hpp"
 #include "IPCRequestHandler.hpp"
+#include "IPCMessageFramer.hpp"
+#include <string>
 
 namespace shipcontrol
 {
 
-class IPCClient : public SingleThread
+// protocol used by the connection, detected from the first received byte
+enum class IPCProtocol
+{
+    UNKNOWN = 0,
+    JSON,
+    BINARY
+};
+
+// per-connection buffers, reused by UnixListener between connections
+struct IPCBuffers
+{
+    IPCMessageFramer in;
+    std::string out;
+};
+
+/*
+ * State of a single client connection.
+ * IPCClient doesn't own a thread, it is driven by UnixListener's event loop,
+ * which calls on_readable()/on_writable() when the non-blocking socket is ready.
+ */
+class IPCClient
 {
 public:
-    IPCClient(int fd, IPCRequestHandler &handler);
+    IPCClient(int fd, IPCRequestHandler &handler, IPCBuffers *buffers);
     IPCClient(const IPCClient &other) = delete;
     virtual ~IPCClient();
 
-    virtual void run();
-    virtual void stop();
-protected:
-    void teardown();
+    // read available data and queue responses to all complete requests in order
+    // returns false if the connection must be closed
+    bool on_readable();
+    // send queued response data; returns false if the connection must be closed
+    bool on_writable();
+    bool has_pending_output() { return _out_pos < _buffers->out.size(); }
+
+    int get_fd() { return _fd; }
+    // epoll events the client's socket is currently registered for
+    unsigned int get_epoll_events() { return _epoll_events; }
+    void set_epoll_events(unsigned int events) { _epoll_events = events; }
+    // give buffers back to the caller, the client must not be used afterwards
+    IPCBuffers *release_buffers();
 
-    const int BUFSIZE = 4096;
+    IPCProtocol get_protocol() { return _protocol; }
+
+    static const std::size_t BUFSIZE = 4096;
+
+protected:
+    // extract and handle complete requests received at the given CLOCK_MONOTONIC time;
+    // returns false if the connection must be closed
+    bool handle_json(long long received);
+    bool handle_binary(long long received);
 
     int _fd;
-    unsigned char *_buf;
+    IPCProtocol _protocol;
+    IPCBuffers *_buffers;
+    // number of bytes of _buffers->out, which have already been sent
+    std::size_t _out_pos;
+    unsigned int _epoll_events;
     Log *_log;
     IPCRequestHandler &_rq_handler;
 };
@@ -30,6 +30,8 @@ class IPCConfig
 {
 public:
     virtual std::string get_unix_socket_name() = 0;
+    // socket exporting metrics, empty if disabled
+    virtual std::string get_metrics_socket_name() { return ""; }
 };
 
 } // namespace shipcontrol
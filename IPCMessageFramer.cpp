@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "IPCMessageFramer.hpp"
+#include <cstring>
+
+namespace shipcontrol
+{
+
+IPCMessageFramer::IPCMessageFramer(std::size_t max_message_size)
+: _max_message_size(max_message_size)
+{
+    reset();
+}
+
+char *IPCMessageFramer::get_write_ptr(std::size_t len)
+{
+    // drop already extracted messages
+    if (_msg_start > 0)
+    {
+        std::memmove(_buf.data(), _buf.data() + _msg_start, _size - _msg_start);
+        _size -= _msg_start;
+        _scan_pos -= _msg_start;
+        _msg_start = 0;
+    }
+
+    if (_buf.size() < _size + len)
+    {
+        _buf.resize(_size + len);
+    }
+
+    return _buf.data() + _size;
+}
+
+void IPCMessageFramer::commit(std::size_t len)
+{
+    _size += len;
+}
+
+bool IPCMessageFramer::next(std::string_view &message)
+{
+    while (_scan_pos < _size)
+    {
+        char c = _buf[_scan_pos++];
+
+        if (_in_string)
+        {
+            if (_escape)
+            {
+                _escape = false;
+            }
+            else if (c == '\\')
+            {
+                _escape = true;
+            }
+            else if (c == '"')
+            {
+                _in_string = false;
+            }
+            else if ((c == '\n') && (_depth == 0))
+            {
+                // unterminated top-level string, don't let it swallow the stream
+                _in_string = false;
+                message = std::string_view(_buf.data() + _msg_start, _scan_pos - 1 - _msg_start);
+                _msg_start = _scan_pos;
+                _started = false;
+                return true;
+            }
+            continue;
+        }
+
+        switch (c)
+        {
+        case '"':
+            _in_string = true;
+            _started = true;
+            break;
+        case '{':
+        case '[':
+            _depth++;
+            _started = true;
+            break;
+        case '}':
+        case ']':
+            _started = true;
+            if (_depth > 0)
+            {
+                _depth--;
+                if (_depth == 0)
+                {
+                    // top-level object or array is complete
+                    message = std::string_view(_buf.data() + _msg_start, _scan_pos - _msg_start);
+                    _msg_start = _scan_pos;
+                    _started = false;
+                    return true;
+                }
+            }
+            break;
+        case '\n':
+            if (_depth == 0)
+            {
+                if (_started)
+                {
+                    message = std::string_view(_buf.data() + _msg_start, _scan_pos - 1 - _msg_start);
+                    _msg_start = _scan_pos;
+                    _started = false;
+                    return true;
+                }
+                _msg_start = _scan_pos;
+            }
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+            if ((_depth == 0) && (_started == false))
+            {
+                // skip whitespace between messages
+                _msg_start = _scan_pos;
+            }
+            break;
+        default:
+            _started = true;
+            break;
+        }
+    }
+
+    return false;
+}
+
+void IPCMessageFramer::consume(std::size_t len)
+{
+    _msg_start += len;
+    if (_scan_pos < _msg_start)
+    {
+        _scan_pos = _msg_start;
+    }
+}
+
+bool IPCMessageFramer::is_overflow()
+{
+    return ((_size - _msg_start) > _max_message_size);
+}
+
+void IPCMessageFramer::reset()
+{
+    _size = 0;
+    _msg_start = 0;
+    _scan_pos = 0;
+    _depth = 0;
+    _in_string = false;
+    _escape = false;
+    _started = false;
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IPCMESSAGEFRAMER_HPP
+#define IPCMESSAGEFRAMER_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace shipcontrol
+{
+
+// max size of a single request message
+#define IPC_MAX_MESSAGE_SIZE    65536
+
+/*
+ * Streaming splitter of the IPC byte stream into request messages.
+ *
+ * Requests are newline-delimited JSON. For compatibility with clients, which
+ * send a single JSON object per write without a terminator, a message also
+ * ends as soon as its top-level JSON object is closed. Anything else is
+ * terminated by '\n' only. Blank lines between messages are skipped.
+ *
+ * Data may arrive in arbitrary pieces: a message may be split between reads
+ * and a single read may carry several messages.
+ */
+class IPCMessageFramer
+{
+public:
+    IPCMessageFramer(std::size_t max_message_size = IPC_MAX_MESSAGE_SIZE);
+
+    // returns space for at least len bytes of incoming data
+    char *get_write_ptr(std::size_t len);
+    // appends len bytes written through get_write_ptr() to the stream
+    void commit(std::size_t len);
+
+    // extracts the next complete message; returns false if more data is needed
+    // message view is valid until the next call to get_write_ptr() or reset()
+    bool next(std::string_view &message);
+    // raw access to received data, which hasn't been extracted yet
+    std::string_view get_pending() const { return std::string_view(_buf.data() + _msg_start, _size - _msg_start); }
+    void consume(std::size_t len);
+    // true if incomplete message has grown beyond max message size
+    bool is_overflow();
+
+    void reset();
+
+protected:
+    std::vector<char> _buf;
+    std::size_t _size;
+    std::size_t _max_message_size;
+    // start of the current message
+    std::size_t _msg_start;
+    // position of the next byte to scan
+    std::size_t _scan_pos;
+    // scanner state
+    unsigned int _depth;
+    bool _in_string;
+    bool _escape;
+    // current message has non-whitespace content
+    bool _started;
+};
+
+} // namespace shipcontrol
+
+#endif // IPCMESSAGEFRAMER_HPP
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2023 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -20,82 +20,232 @@
 
 #include <stdexcept>
 #include "IPCRequestHandler.hpp"
+#include "Clock.hpp"
 #include "json.hpp"
+#include "Metrics.hpp"
 
 using json = nlohmann::json;
 
 namespace shipcontrol
 {
 
-IPCRequestHandler::IPCRequestHandler(InputQueue &queue, DataProvider &provider)
+// responses to commands are constant, so they are not serialized on every request
+static const char RESP_OK[] = "{\"error\":\"\",\"status\":\"ok\"}";
+static const char RESP_INVALID_CMD[] = "{\"error\":\"invalid command\",\"status\":\"fail\"}";
+static const char RESP_QUEUE_FULL[] = "{\"error\":\"queue full\",\"status\":\"fail\"}";
+
+// request types of metrics
+enum IPCMetricType
+{
+    IPC_METRIC_CMD = 0,
+    IPC_METRIC_QUERY,
+    IPC_METRIC_BINARY,
+    IPC_METRIC_INVALID
+};
+
+static Metric *ipc_requests[] = {
+    Metrics::counter("shipcontrol_ipc_requests_total", "IPC requests by type", "type=\"cmd\""),
+    Metrics::counter("shipcontrol_ipc_requests_total", "IPC requests by type", "type=\"query\""),
+    Metrics::counter("shipcontrol_ipc_requests_total", "IPC requests by type", "type=\"binary\""),
+    Metrics::counter("shipcontrol_ipc_requests_total", "IPC requests by type", "type=\"invalid\"")
+};
+static Metric *ipc_errors[] = {
+    Metrics::counter("shipcontrol_ipc_errors_total", "Failed IPC requests by type", "type=\"cmd\""),
+    Metrics::counter("shipcontrol_ipc_errors_total", "Failed IPC requests by type", "type=\"query\""),
+    Metrics::counter("shipcontrol_ipc_errors_total", "Failed IPC requests by type", "type=\"binary\""),
+    Metrics::counter("shipcontrol_ipc_errors_total", "Failed IPC requests by type", "type=\"invalid\"")
+};
+
+IPCRequestHandler::IPCRequestHandler(InputQueue &queue, DataProvider &provider, const QueryCache *cache)
 : _input_queue(queue),
-  _data_provider(provider)
+  _data_provider(provider),
+  _query_cache(cache)
 {
+    _latency_stats = _data_provider.get_latency_stats();
+}
+
+std::string IPCRequestHandler::handleRequest(std::string_view request, long long received)
+{
+    IPCRequest rq;
+
+    if (IPCRequestParser::parse(request, rq))
+    {
+        return dispatch(rq, received);
+    }
+
+    return handle_request_json(request, received);
+}
+
+void IPCRequestHandler::handleRequest(const IPCBinaryRequest &request, IPCBinaryReply &reply, long long received)
+{
+    InputEvent evt;
+    evt.type = InputEventType::UNKNOWN;
+    evt.source = InputSource::IPC;
+
+    bool valid_value = (request.value >= -SETPOINT_MAX) && (request.value <= SETPOINT_MAX);
+
+    switch (static_cast<IPCBinaryOpcode>(request.opcode))
+    {
+    case IPCBinaryOpcode::SPEED_UP:
+        evt.type = InputEventType::SPEED_UP;
+        break;
+    case IPCBinaryOpcode::SPEED_DOWN:
+        evt.type = InputEventType::SPEED_DOWN;
+        break;
+    case IPCBinaryOpcode::TURN_LEFT:
+        evt.type = InputEventType::TURN_LEFT;
+        break;
+    case IPCBinaryOpcode::TURN_RIGHT:
+        evt.type = InputEventType::TURN_RIGHT;
+        break;
+    case IPCBinaryOpcode::SET_SPEED:
+        if (valid_value)
+        {
+            evt.type = InputEventType::SET_SPEED;
+            evt.speed = request.value;
+        }
+        break;
+    case IPCBinaryOpcode::SET_STEERING:
+        if (valid_value)
+        {
+            evt.type = InputEventType::SET_STEERING;
+            evt.steering = request.value;
+        }
+        break;
+    default:
+        break;
+    }
+
+    ipc_requests[IPC_METRIC_BINARY]->inc();
+
+    reply = IPCBinaryReply{};
+    reply.magic = IPC_BINARY_MAGIC;
+    reply.seq = request.seq;
+    reply.timestamp = request.timestamp;
+
+    if (evt.type != InputEventType::UNKNOWN)
+    {
+        if (push_event(evt, received))
+        {
+            reply.status = static_cast<std::uint8_t>(IPCBinaryStatus::OK);
+        }
+        else
+        {
+            // the command has been dropped
+            reply.status = static_cast<std::uint8_t>(IPCBinaryStatus::FAIL);
+            ipc_errors[IPC_METRIC_BINARY]->inc();
+        }
+    }
+    else if (static_cast<IPCBinaryOpcode>(request.opcode) == IPCBinaryOpcode::QUERY)
+    {
+        reply.status = static_cast<std::uint8_t>(IPCBinaryStatus::OK);
+    }
+    else
+    {
+        reply.status = static_cast<std::uint8_t>(IPCBinaryStatus::FAIL);
+        ipc_errors[IPC_METRIC_BINARY]->inc();
+    }
+
+    // setpoints are written by the main loop, the cache publishes them safely
+    Setpoint speed;
+    Setpoint steering;
+    if ((_query_cache == nullptr) || (_query_cache->read_setpoints(speed, steering) == false))
+    {
+        speed = _data_provider.get_speed_setpoint();
+        steering = _data_provider.get_steering_setpoint();
+    }
+    reply.speed = speed;
+    reply.steering = steering;
 }
 
-std::string IPCRequestHandler::handleRequest(const std::string &request)
+std::string IPCRequestHandler::handle_request_json(std::string_view request, long long received)
 {
     try
     {
         json json_rq = json::parse(request);
+        IPCRequest rq{};
+        // keep values alive while rq refers to them
+        std::string type;
+        std::string cmd;
+        std::string data;
 
         if (json_rq.find("type") != json_rq.end())
         {
-            std::string rq_type = json_rq["type"].get<std::string>();
-            if (rq_type == "cmd")
-            {
-                if (json_rq.find("cmd") != json_rq.end())
-                {
-                    std::string cmd = json_rq["cmd"].get<std::string>();
-                    std::string data;
-                    if ((cmd == "set_speed") || (cmd == "set_steering"))
-                    {
-                        if (json_rq.find("data") != json_rq.end())
-                        {
-                            data = json_rq["data"].get<std::string>();
-                        }
-                        else
-                        {
-                            throw std::invalid_argument("no data for set_speed or set_steering command");
-                        }
-                    }
-                    return handle_cmd(cmd, data);
-                }
-                else
-                {
-                    throw std::invalid_argument("no command inside command request");
-                }
-            }
-            else if (rq_type == "query")
-            {
-                return handle_query();
-            }
-            else
-            {
-                throw std::invalid_argument("invalid request type");
-            }
+            type = json_rq["type"].get<std::string>();
+            rq.type = type;
+            rq.has_type = true;
         }
-        else
+        if (json_rq.find("cmd") != json_rq.end())
+        {
+            cmd = json_rq["cmd"].get<std::string>();
+            rq.cmd = cmd;
+            rq.has_cmd = true;
+        }
+        if ((json_rq.find("data") != json_rq.end()) && json_rq["data"].is_string())
         {
-            throw std::invalid_argument("invalid request message, request type not found");
+            data = json_rq["data"].get<std::string>();
+            rq.data = data;
+            rq.has_data = true;
         }
+
+        return dispatch(rq, received);
     }
     catch (const std::exception &e)
     {
-        json json_resp;
+        ipc_requests[IPC_METRIC_INVALID]->inc();
+        ipc_errors[IPC_METRIC_INVALID]->inc();
+        return make_error(e.what());
+    }
+}
 
-        json_resp["status"] = "fail";
-        json_resp["error"] = e.what();
+std::string IPCRequestHandler::dispatch(const IPCRequest &rq, long long received)
+{
+    if (rq.has_type == false)
+    {
+        ipc_requests[IPC_METRIC_INVALID]->inc();
+        ipc_errors[IPC_METRIC_INVALID]->inc();
+        return make_error("invalid request message, request type not found");
+    }
 
-        return json_resp.dump();
+    if (rq.type == "cmd")
+    {
+        ipc_requests[IPC_METRIC_CMD]->inc();
+        if (rq.has_cmd == false)
+        {
+            ipc_errors[IPC_METRIC_CMD]->inc();
+            return make_error("no command inside command request");
+        }
+        if (((rq.cmd == "set_speed") || (rq.cmd == "set_steering")) && (rq.has_data == false))
+        {
+            ipc_errors[IPC_METRIC_CMD]->inc();
+            return make_error("no data for set_speed or set_steering command");
+        }
+        return handle_cmd(rq.cmd, rq.data, received);
     }
+    else if (rq.type == "query")
+    {
+        ipc_requests[IPC_METRIC_QUERY]->inc();
+        if (rq.has_cmd && (rq.cmd == "telemetry"))
+        {
+            return handle_telemetry_query();
+        }
+        if (rq.has_cmd && (rq.cmd == "latency"))
+        {
+            return handle_latency_query();
+        }
+        return handle_query();
+    }
+
+    ipc_requests[IPC_METRIC_INVALID]->inc();
+    ipc_errors[IPC_METRIC_INVALID]->inc();
+    return make_error("invalid request type");
 }
 
-std::string IPCRequestHandler::handle_cmd(const std::string &cmd, const std::string &data)
+std::string IPCRequestHandler::handle_cmd(std::string_view cmd, std::string_view data, long long received)
 {
     InputEvent evt;
     evt.type = InputEventType::UNKNOWN;
-    json json_resp;
+    evt.source = InputSource::IPC;
 
     if (cmd == "speed_up")
     {
@@ -115,52 +265,130 @@ std::string IPCRequestHandler::handle_cmd(const std::string &cmd, const std::str
     }
     else if (cmd == "set_speed")
     {
-        if (ServoController::validate_speed_str(data) == true)
+        SpeedVal speed;
+        if (ServoController::parse_speed(data, speed) == true)
         {
             evt.type = InputEventType::SET_SPEED;
-            evt.data = data;
-        }
-        else
-        {
-            evt.type = InputEventType::UNKNOWN;
+            evt.speed = ServoController::speed_to_setpoint(speed);
         }
     }
     else if (cmd == "set_steering")
     {
-        if (ServoController::validate_steering_str(data) == true)
+        SteeringVal steering;
+        if (ServoController::parse_steering(data, steering) == true)
         {
             evt.type = InputEventType::SET_STEERING;
-            evt.data = data;
-        }
-        else
-        {
-            evt.type = InputEventType::UNKNOWN;
+            evt.steering = ServoController::steering_to_setpoint(steering);
         }
     }
 
     if (evt.type != InputEventType::UNKNOWN)
     {
-        _input_queue.push(evt);
-        json_resp["status"] = "ok";
-        json_resp["error"] = "";
+        if (push_event(evt, received) == false)
+        {
+            ipc_errors[IPC_METRIC_CMD]->inc();
+            return RESP_QUEUE_FULL;
+        }
+        return RESP_OK;
     }
-    else
+
+    ipc_errors[IPC_METRIC_CMD]->inc();
+    return RESP_INVALID_CMD;
+}
+
+std::string IPCRequestHandler::handle_query()
+{
+    std::string resp;
+    if ((_query_cache != nullptr) && _query_cache->read(resp))
     {
-        json_resp["status"] = "fail";
-        json_resp["error"] = "invalid command";
+        return resp;
     }
 
-    return json_resp.dump();
+    json j;
+
+    j["speed"] = ServoController::speed_name(ServoController::setpoint_to_speed(_data_provider.get_speed_setpoint()));
+    j["steering"] = ServoController::steering_name(ServoController::setpoint_to_steering(_data_provider.get_steering_setpoint()));
+
+    return j.dump();
 }
 
-std::string IPCRequestHandler::handle_query()
+std::string IPCRequestHandler::handle_telemetry_query()
 {
+    MaestroTelemetryData data;
+    if (_data_provider.get_maestro_telemetry(data) == false)
+    {
+        ipc_errors[IPC_METRIC_QUERY]->inc();
+        return make_error("telemetry is not available");
+    }
+
     json j;
+    j["status"] = "ok";
+    j["error"] = "";
+    json positions = json::array();
+    for (unsigned int i = 0; i < data.channel_count; i++)
+    {
+        positions.push_back({{"channel", data.channels[i]}, {"position", data.positions[i]}});
+    }
+    j["positions"] = positions;
+    j["moving"] = data.moving;
+    j["errors"] = data.errors;
+    j["polls"] = data.polls;
+    j["timeouts"] = data.timeouts;
+
+    j["age_ms"] = (monotonic_now() - data.updated) / 1000000;
+
+    return j.dump();
+}
+
+std::string IPCRequestHandler::handle_latency_query()
+{
+    if (_latency_stats == nullptr)
+    {
+        ipc_errors[IPC_METRIC_QUERY]->inc();
+        return make_error("latency is not available");
+    }
+
+    json stages = json::object();
+    for (int i = 0; i < static_cast<int>(LatencyStage::COUNT); i++)
+    {
+        LatencyStage stage = static_cast<LatencyStage>(i);
+        const LatencyHistogram &histogram = _latency_stats->get(stage);
+        stages[LatencyStats::stage_name(stage)] = {
+            {"count", histogram.get_count()},
+            {"p50", histogram.get_percentile(0.5)},
+            {"p90", histogram.get_percentile(0.9)},
+            {"p99", histogram.get_percentile(0.99)},
+            {"p999", histogram.get_percentile(0.999)},
+            {"max", histogram.get_max()}
+        };
+    }
 
-    j["speed"] = ServoController::speed_to_str(_data_provider.get_speed());
-    j["steering"] = ServoController::steering_to_str(_data_provider.get_steering());
+    json j;
+    j["status"] = "ok";
+    j["error"] = "";
+    j["stages"] = stages;
 
     return j.dump();
 }
 
+bool IPCRequestHandler::push_event(InputEvent &evt, long long received)
+{
+    evt.time = received;
+    if ((received != 0) && (_latency_stats != nullptr))
+    {
+        _latency_stats->record(LatencyStage::IPC, monotonic_now() - received);
+    }
+    return _input_queue.push(evt);
+}
+
+std::string IPCRequestHandler::make_error(const char *error)
+{
+    json json_resp;
+
+    json_resp["status"] = "fail";
+    json_resp["error"] = error;
+
+    return json_resp.dump();
+}
+
 } // namespace shipcontrol
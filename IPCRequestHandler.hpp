@@ -23,7 +23,11 @@
 
 #include "InputQueue.hpp"
 #include "DataProvider.hpp"
+#include "QueryCache.hpp"
+#include "IPCRequestParser.hpp"
+#include "IPCBinaryProtocol.hpp"
 #include <string>
+#include <string_view>
 
 namespace shipcontrol
 {
@@ -34,6 +38,8 @@ namespace shipcontrol
  * {
  *     "type": "cmd" or "query",
  *     "cmd" (in case of cmd type): one of "speed_up", "speed_down", "turn_left", "turn_right", "set_speed", "set_steering"
+ *     "cmd" (optional in case of query type): "telemetry" to query Maestro telemetry,
+ *                                             "latency" to query input-to-actuation latency
  *     "data" (optional): target speed or target steering in case of "set_speed" or "set_steering" command
  * }
  *
@@ -51,19 +57,65 @@ namespace shipcontrol
  *     "speed": "<value>",
  *     "steering": "<value>"
  * }
+ * Values are rounded to the nearest 10% step.
+ *
+ * IPC telemetry query response format:
+ * JSON
+ * {
+ *     "status": "ok",
+ *     "error": "",
+ *     "positions": [{"channel": <channel>, "position": <quarter-microseconds>}, ...],
+ *     "moving": true or false,
+ *     "errors": <Maestro error bits>,
+ *     "polls": <completed polling cycles>,
+ *     "timeouts": <polling cycles dropped because of timeout>,
+ *     "age_ms": <milliseconds since the last update>
+ * }
+ *
+ * IPC latency query response format:
+ * JSON
+ * {
+ *     "status": "ok",
+ *     "error": "",
+ *     "stages": {
+ *         "<stage>": {"count": <samples>, "p50": <ns>, "p90": <ns>, "p99": <ns>, "p999": <ns>, "max": <ns>},
+ *         ...
+ *     }
+ * }
+ * Stages are "evdev", "ipc", "queue", "apply" and "total", see LatencyStats.hpp.
+ *
+ * On the unix socket requests are delimited by '\n' (a single unterminated
+ * request object is accepted too, see IPCMessageFramer), responses are
+ * terminated by '\n' and sent in the order of requests.
+ * Clients may use binary protocol instead of JSON, see IPCBinaryProtocol.hpp.
  */
 
 class IPCRequestHandler
 {
 public:
-    IPCRequestHandler(InputQueue &queue, DataProvider &provider);
-    std::string handleRequest(const std::string &request);
+    // if query cache is given, queries are answered with its snapshot instead of
+    // serializing data provider's status on every request
+    IPCRequestHandler(InputQueue &queue, DataProvider &provider, const QueryCache *cache = nullptr);
+    // received is CLOCK_MONOTONIC time of request reception in nanoseconds, 0 if unknown
+    std::string handleRequest(std::string_view request, long long received = 0);
+    // binary protocol request, see IPCBinaryProtocol.hpp
+    void handleRequest(const IPCBinaryRequest &request, IPCBinaryReply &reply, long long received = 0);
 protected:
-    std::string handle_cmd(const std::string &cmd, const std::string &data);
+    // full JSON parser path for requests rejected by IPCRequestParser
+    std::string handle_request_json(std::string_view request, long long received);
+    std::string dispatch(const IPCRequest &rq, long long received);
+    std::string handle_cmd(std::string_view cmd, std::string_view data, long long received);
     std::string handle_query();
+    std::string handle_telemetry_query();
+    std::string handle_latency_query();
+    // returns false if the input queue is full and the event has been dropped
+    bool push_event(InputEvent &evt, long long received);
+    static std::string make_error(const char *error);
 
     InputQueue &_input_queue;
     DataProvider &_data_provider;
+    const QueryCache *_query_cache;
+    LatencyStats *_latency_stats;
 };
 
 } // namespace shipcontrol
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "IPCRequestParser.hpp"
+
+namespace shipcontrol
+{
+
+namespace
+{
+
+void skip_ws(std::string_view msg, std::size_t &pos)
+{
+    while ((pos < msg.size()) &&
+           ((msg[pos] == ' ') || (msg[pos] == '\t') || (msg[pos] == '\n') || (msg[pos] == '\r')))
+    {
+        pos++;
+    }
+}
+
+// read string starting at the opening quote, escapes are not supported
+bool read_string(std::string_view msg, std::size_t &pos, std::string_view &str)
+{
+    if ((pos >= msg.size()) || (msg[pos] != '"'))
+    {
+        return false;
+    }
+    std::size_t start = ++pos;
+    while (pos < msg.size())
+    {
+        char c = msg[pos];
+        if (c == '"')
+        {
+            str = msg.substr(start, pos - start);
+            pos++;
+            return true;
+        }
+        if ((c == '\\') || (static_cast<unsigned char>(c) < 0x20))
+        {
+            return false;
+        }
+        pos++;
+    }
+    return false;
+}
+
+bool set_field(std::string_view value, std::string_view &field, bool &has_field)
+{
+    if (has_field)
+    {
+        // duplicate key
+        return false;
+    }
+    field = value;
+    has_field = true;
+    return true;
+}
+
+} // anonymous namespace
+
+bool IPCRequestParser::parse(std::string_view msg, IPCRequest &rq)
+{
+    std::size_t pos = 0;
+
+    rq.has_type = false;
+    rq.has_cmd = false;
+    rq.has_data = false;
+
+    skip_ws(msg, pos);
+    if ((pos >= msg.size()) || (msg[pos] != '{'))
+    {
+        return false;
+    }
+    pos++;
+    skip_ws(msg, pos);
+
+    if ((pos < msg.size()) && (msg[pos] == '}'))
+    {
+        pos++;
+    }
+    else
+    {
+        while (true)
+        {
+            std::string_view key;
+            std::string_view value;
+
+            if (read_string(msg, pos, key) == false)
+            {
+                return false;
+            }
+            skip_ws(msg, pos);
+            if ((pos >= msg.size()) || (msg[pos] != ':'))
+            {
+                return false;
+            }
+            pos++;
+            skip_ws(msg, pos);
+            if (read_string(msg, pos, value) == false)
+            {
+                return false;
+            }
+
+            bool ok = true;
+            if (key == "type")
+            {
+                ok = set_field(value, rq.type, rq.has_type);
+            }
+            else if (key == "cmd")
+            {
+                ok = set_field(value, rq.cmd, rq.has_cmd);
+            }
+            else if (key == "data")
+            {
+                ok = set_field(value, rq.data, rq.has_data);
+            }
+            if (ok == false)
+            {
+                return false;
+            }
+
+            skip_ws(msg, pos);
+            if (pos >= msg.size())
+            {
+                return false;
+            }
+            if (msg[pos] == '}')
+            {
+                pos++;
+                break;
+            }
+            if (msg[pos] != ',')
+            {
+                return false;
+            }
+            pos++;
+            skip_ws(msg, pos);
+        }
+    }
+
+    skip_ws(msg, pos);
+    return (pos == msg.size());
+}
+
+} // namespace shipcontrol
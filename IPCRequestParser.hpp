@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IPCREQUESTPARSER_HPP
+#define IPCREQUESTPARSER_HPP
+
+#include <string_view>
+
+namespace shipcontrol
+{
+
+// fields of IPC request, views point into the request message
+struct IPCRequest
+{
+    std::string_view type;
+    std::string_view cmd;
+    std::string_view data;
+    bool has_type;
+    bool has_cmd;
+    bool has_data;
+};
+
+/*
+ * Allocation-free parser for the common shape of IPC requests: a flat JSON
+ * object with string values without escape sequences.
+ * Anything else (escapes, non-string values, nested objects, duplicate keys,
+ * malformed input) is rejected, and the caller is expected to fall back
+ * to the full JSON parser, which produces proper error messages.
+ */
+class IPCRequestParser
+{
+public:
+    // returns false if the request must be handled by the full parser
+    static bool parse(std::string_view msg, IPCRequest &rq);
+};
+
+} // namespace shipcontrol
+
+#endif // IPCREQUESTPARSER_HPP
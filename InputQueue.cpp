@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,47 +19,214 @@
  */
 
 #include "InputQueue.hpp"
+#include "Clock.hpp"
+#include "Metrics.hpp"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <ctime>
 
 namespace shipcontrol
 {
 
-InputQueue::InputQueue()
+// shared by all queues
+static Metric *queue_depth = Metrics::gauge("shipcontrol_input_queue_depth",
+                                            "Input events waiting in the queue");
+static Metric *queue_dropped = Metrics::counter("shipcontrol_input_events_dropped_total",
+                                                "Input events dropped because the queue was full");
+// indexed by InputSource
+static Metric *queue_events[] = {
+    Metrics::counter("shipcontrol_input_events_total", "Input events queued by source", "source=\"unknown\""),
+    Metrics::counter("shipcontrol_input_events_total", "Input events queued by source", "source=\"evdev\""),
+    Metrics::counter("shipcontrol_input_events_total", "Input events queued by source", "source=\"ipc\""),
+    Metrics::counter("shipcontrol_input_events_total", "Input events queued by source", "source=\"cmdline\"")
+};
+
+/*
+ * The queue is a bounded ring of slots, each of which carries a sequence
+ * number (see D. Vyukov's bounded MPMC queue). For the slot at position pos:
+ *   seq == pos             - the slot is free and may be taken by a producer
+ *   seq == pos + 1         - the slot holds an event ready to be consumed
+ *   seq == pos + capacity  - the slot has been consumed and is free for the next lap
+ * Producers claim positions with CAS on _head, the only consumer advances _tail.
+ */
+
+InputQueue::InputQueue(std::size_t capacity)
+: _head(0),
+  _tail(0),
+  _wake_seq(0),
+  _consumer_waiting(false),
+  _dropped(0)
 {
+    // round capacity up to the power of two, so that position can be masked
+    _capacity = 2;
+    while (_capacity < capacity)
+    {
+        _capacity <<= 1;
+    }
+    _mask = _capacity - 1;
+
+    _slots = new Slot[_capacity];
+    for (std::size_t i = 0; i < _capacity; i++)
+    {
+        _slots[i].seq.store(i, std::memory_order_relaxed);
+    }
 }
 
 InputQueue::~InputQueue()
 {
+    queue_depth->dec(static_cast<std::int64_t>(_head.load() - _tail));
+    delete [] _slots;
+}
+
+bool InputQueue::push(InputEvent event)
+{
+    Slot *slot = nullptr;
+    std::size_t pos = _head.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        slot = &_slots[pos & _mask];
+        std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the consumer hasn't freed this slot yet, the queue is full
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            queue_dropped->inc();
+            return false;
+        }
+        else
+        {
+            // another producer has taken this position, retry with the new one
+            pos = _head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->event = event;
+    slot->event.queued = monotonic_now();
+    slot->seq.store(pos + 1, std::memory_order_release);
+
+    std::size_t source = static_cast<std::size_t>(event.source);
+    queue_events[(source < sizeof(queue_events) / sizeof(queue_events[0])) ? source : 0]->inc();
+    queue_depth->inc();
+
+    wake_consumer();
+    return true;
 }
 
-void InputQueue::push(InputEvent event)
+bool InputQueue::try_pop(InputEvent &event)
 {
+    Slot *slot = &_slots[_tail & _mask];
+    std::size_t seq = slot->seq.load(std::memory_order_acquire);
+
+    if (seq != _tail + 1)
     {
-        std::lock_guard<std::mutex> queue_lock(_queue_mutex);
-        std::lock_guard<std::mutex> block_lock(_block_mutex);
-        _queue.push(event);
+        return false;
     }
-    _block_var.notify_all();
+
+    event = slot->event;
+    slot->seq.store(_tail + _capacity, std::memory_order_release);
+    _tail++;
+    queue_depth->dec();
+
+    return true;
 }
 
 InputEvent InputQueue::pop()
 {
-    std::lock_guard<std::mutex> lock(_queue_mutex);
-    InputEvent evt = _queue.front();
-    _queue.pop();
+    InputEvent evt{InputEventType::UNKNOWN};
+    try_pop(evt);
     return evt;
 }
 
 InputEvent InputQueue::pop_blocking()
 {
-    std::unique_lock<std::mutex> lock(_block_mutex);
-    _block_var.wait(lock, [this](){ return !is_empty(); });
-    lock.unlock();
-    return pop();
+    InputEvent evt;
+
+    while (true)
+    {
+        if (try_pop(evt))
+        {
+            return evt;
+        }
+
+        // remember wake sequence before the second check, so that push
+        // happening in between is not lost: futex won't sleep if the
+        // sequence has changed
+        std::uint32_t seq = _wake_seq.load(std::memory_order_seq_cst);
+        _consumer_waiting.store(true, std::memory_order_seq_cst);
+
+        if (try_pop(evt))
+        {
+            _consumer_waiting.store(false, std::memory_order_relaxed);
+            return evt;
+        }
+
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&_wake_seq),
+                FUTEX_WAIT_PRIVATE, seq, nullptr, nullptr, 0);
+        _consumer_waiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool InputQueue::pop_until(InputEvent &event, long long deadline)
+{
+    timespec ts;
+    ts.tv_sec = deadline / 1000000000LL;
+    ts.tv_nsec = deadline % 1000000000LL;
+
+    while (true)
+    {
+        if (try_pop(event))
+        {
+            return true;
+        }
+
+        std::uint32_t seq = _wake_seq.load(std::memory_order_seq_cst);
+        _consumer_waiting.store(true, std::memory_order_seq_cst);
+
+        if (try_pop(event))
+        {
+            _consumer_waiting.store(false, std::memory_order_relaxed);
+            return true;
+        }
+
+        // FUTEX_WAIT_BITSET takes absolute CLOCK_MONOTONIC timeout
+        long ret = syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&_wake_seq),
+                           FUTEX_WAIT_BITSET_PRIVATE, seq, &ts, nullptr, FUTEX_BITSET_MATCH_ANY);
+        _consumer_waiting.store(false, std::memory_order_relaxed);
+
+        if ((ret == -1) && (errno == ETIMEDOUT))
+        {
+            return try_pop(event);
+        }
+    }
 }
 
 bool InputQueue::is_empty()
 {
-    return _queue.empty();
+    Slot *slot = &_slots[_tail & _mask];
+    return (slot->seq.load(std::memory_order_acquire) != _tail + 1);
+}
+
+void InputQueue::wake_consumer()
+{
+    _wake_seq.fetch_add(1, std::memory_order_seq_cst);
+    // skip the system call if the consumer isn't sleeping
+    if (_consumer_waiting.load(std::memory_order_seq_cst))
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&_wake_seq),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
 }
 
 } // namespace shipcontrol
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2024 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -21,14 +21,20 @@
 #ifndef INPUT_QUEUE_HPP
 #define INPUT_QUEUE_HPP
 
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <string>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ServoController.hpp" // included for Setpoint definition
 
 namespace shipcontrol
 {
 
+// default number of events the queue can hold
+#define INPUT_QUEUE_CAPACITY    256
+#define CACHE_LINE_SIZE         64
+
 enum class InputEventType
 {
     UNKNOWN,
@@ -40,29 +46,87 @@ enum class InputEventType
     SET_STEERING
 };
 
+// origin of an input event
+enum class InputSource : std::uint8_t
+{
+    UNKNOWN = 0,
+    EVDEV,
+    IPC,
+    CMDLINE
+};
+
 struct InputEvent
 {
     InputEventType type;
-    std::string data;
+    // validated target setpoint, used by SET_SPEED and SET_STEERING events only
+    union
+    {
+        Setpoint speed;
+        Setpoint steering;
+    };
+    InputSource source;
+    // CLOCK_MONOTONIC time of the input in nanoseconds (kernel event time,
+    // IPC request reception), 0 if unknown
+    long long time;
+    // CLOCK_MONOTONIC time of pushing to the queue, set by push()
+    long long queued;
 };
 
-// a thread-safe queue of input events
+// events are copied around by value, make sure it stays cheap
+static_assert(std::is_trivially_copyable<InputEvent>::value, "InputEvent must be trivially copyable");
+
+/*
+ * A thread-safe bounded queue of input events.
+ * Any number of threads may push events, but only one thread (the main
+ * event loop) may pop them. The queue never allocates after construction.
+ * When the queue is full, push() rejects the new event and increments the
+ * dropped events counter.
+ */
 class InputQueue
 {
 public:
-    InputQueue();
+    InputQueue(std::size_t capacity = INPUT_QUEUE_CAPACITY);
+    InputQueue(const InputQueue &other) = delete;
     virtual ~InputQueue();
 
-    void push(InputEvent event);
+    // returns false if the queue is full and the event has been dropped
+    bool push(InputEvent event);
+    // returns UNKNOWN event if the queue is empty
     InputEvent pop();
     // pop_blocking blocks the calling thread until there's data in the queue
     InputEvent pop_blocking();
+    // non-blocking pop, returns false if the queue is empty
+    bool try_pop(InputEvent &event);
+    // blocks until there's data in the queue or until deadline given as
+    // CLOCK_MONOTONIC time in nanoseconds; returns false on timeout
+    bool pop_until(InputEvent &event, long long deadline);
     bool is_empty();
+
+    std::size_t get_capacity() { return _capacity; }
+    std::uint64_t get_dropped() { return _dropped.load(std::memory_order_relaxed); }
+
 protected:
-    std::queue<InputEvent> _queue;
-    std::mutex _queue_mutex;
-    std::mutex _block_mutex;
-    std::condition_variable _block_var;
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+        // slot sequence number, tells whether the slot is free or holds an event
+        std::atomic<std::size_t> seq;
+        InputEvent event;
+    };
+
+    Slot *_slots;
+    std::size_t _capacity;
+    std::size_t _mask;
+
+    // producers' position
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _head;
+    // consumer's position, only accessed by the consumer
+    alignas(CACHE_LINE_SIZE) std::size_t _tail;
+    // futex word, incremented on every push to wake the consumer up
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> _wake_seq;
+    std::atomic<bool> _consumer_waiting;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> _dropped;
+
+    void wake_consumer();
 };
 
 } // namespace shipcontrol
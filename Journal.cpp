@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Journal.hpp"
+#include "Clock.hpp"
+
+namespace shipcontrol
+{
+
+Journal::Journal(const JournalConfig &config) :
+    _config(config),
+    _map(nullptr),
+    _map_size(0),
+    _header(nullptr),
+    _entries(nullptr),
+    _need_to_stop(false)
+{
+    _log = Log::getInstance();
+
+    if (_config.entries == 0)
+    {
+        _log->write(LogLevel::ERROR, "Journal: number of entries must not be 0\n");
+        return;
+    }
+    if (_config.sync_period == 0)
+    {
+        _log->write(LogLevel::ERROR, "Journal: sync period must not be 0\n");
+        return;
+    }
+
+    // keep the journal of the previous run, it's the one to analyze after a crash
+    std::string previous = _config.path + ".1";
+    if ((rename(_config.path.c_str(), previous.c_str()) == -1) && (errno != ENOENT))
+    {
+        _log->write(LogLevel::ERROR, "Journal failed to rename %s to %s, errno=%d\n",
+                    _config.path.c_str(), previous.c_str(), errno);
+    }
+
+    int fd = open(_config.path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "Journal failed to open %s, errno=%d\n",
+                    _config.path.c_str(), errno);
+        return;
+    }
+
+    std::size_t size = JOURNAL_HEADER_SIZE + static_cast<std::size_t>(_config.entries) * sizeof(JournalEntry);
+    if (ftruncate(fd, size) == -1)
+    {
+        _log->write(LogLevel::ERROR, "Journal failed to resize %s, errno=%d\n",
+                    _config.path.c_str(), errno);
+        close(fd);
+        return;
+    }
+
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        _log->write(LogLevel::ERROR, "Journal failed to map %s, errno=%d\n",
+                    _config.path.c_str(), errno);
+        return;
+    }
+
+    _map = map;
+    _map_size = size;
+    // the file is zero-filled, so all entries are empty
+    _header = new (map) JournalHeader;
+    std::memcpy(_header->magic, JOURNAL_MAGIC, sizeof(_header->magic));
+    _header->entry_size = sizeof(JournalEntry);
+    _header->capacity = _config.entries;
+    _header->seq.store(0, std::memory_order_relaxed);
+    _entries = reinterpret_cast<JournalEntry *>(static_cast<char *>(map) + JOURNAL_HEADER_SIZE);
+
+    _thread = std::thread(&Journal::run, this);
+}
+
+Journal::~Journal()
+{
+    if (_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_stop_mutex);
+            _need_to_stop = true;
+        }
+        _stop_cond.notify_one();
+        _thread.join();
+    }
+
+    if (_map != nullptr)
+    {
+        sync();
+        munmap(_map, _map_size);
+    }
+    Log::release();
+}
+
+void Journal::record_command(InputSource source, InputEventType command, Setpoint setpoint)
+{
+    JournalEntry entry{};
+    entry.kind = JournalEntryKind::COMMAND;
+    entry.source = static_cast<std::uint8_t>(source);
+    entry.command = static_cast<std::uint8_t>(command);
+    entry.setpoint = setpoint;
+    record(entry);
+}
+
+void Journal::record_output(JournalEntryKind kind, const std::string &controller, Setpoint value)
+{
+    JournalEntry entry{};
+    entry.kind = kind;
+    entry.setpoint = value;
+    std::memcpy(entry.controller, controller.data(),
+                std::min(controller.size(), sizeof(entry.controller)));
+    record(entry);
+}
+
+void Journal::record(JournalEntry &entry)
+{
+    if (_header == nullptr)
+    {
+        return;
+    }
+
+    entry.time = monotonic_now();
+    entry.seq = _header->seq.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::memcpy(&_entries[(entry.seq - 1) % _header->capacity], &entry, sizeof(entry));
+}
+
+void Journal::sync()
+{
+    if (_map == nullptr)
+    {
+        return;
+    }
+
+    if (msync(_map, _map_size, MS_ASYNC) == -1)
+    {
+        _log->write(LogLevel::ERROR, "Journal msync failed, errno=%d\n", errno);
+    }
+}
+
+void Journal::run()
+{
+    std::unique_lock<std::mutex> lock(_stop_mutex);
+    while (_need_to_stop == false)
+    {
+        _stop_cond.wait_for(lock, std::chrono::milliseconds(_config.sync_period));
+        sync();
+    }
+}
+
+bool Journal::read(const std::string &path, std::vector<JournalEntry> &entries)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    bool ok = false;
+    struct stat st;
+    char magic[8];
+    std::uint32_t sizes[2];
+    if ((fstat(fd, &st) == 0) &&
+        (pread(fd, magic, sizeof(magic), 0) == sizeof(magic)) &&
+        (std::memcmp(magic, JOURNAL_MAGIC, sizeof(magic)) == 0) &&
+        (pread(fd, sizes, sizeof(sizes), sizeof(magic)) == sizeof(sizes)) &&
+        (sizes[0] == sizeof(JournalEntry)) &&
+        (static_cast<std::uint64_t>(st.st_size) >= JOURNAL_HEADER_SIZE + static_cast<std::uint64_t>(sizes[1]) * sizeof(JournalEntry)))
+    {
+        std::vector<JournalEntry> slots(sizes[1]);
+        std::size_t len = slots.size() * sizeof(JournalEntry);
+        if (pread(fd, slots.data(), len, JOURNAL_HEADER_SIZE) == static_cast<ssize_t>(len))
+        {
+            for (const JournalEntry &entry : slots)
+            {
+                if (entry.seq != 0)
+                {
+                    entries.push_back(entry);
+                }
+            }
+            std::sort(entries.begin(), entries.end(),
+                      [](const JournalEntry &a, const JournalEntry &b) { return a.seq < b.seq; });
+            ok = true;
+        }
+    }
+
+    close(fd);
+    return ok;
+}
+
+} // namespace shipcontrol
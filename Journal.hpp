@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "JournalConfig.hpp"
+#include "InputQueue.hpp"
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+#define JOURNAL_MAGIC           "SCJRNL01"
+#define JOURNAL_CONTROLLER_LEN  16
+// entries start at this file offset
+#define JOURNAL_HEADER_SIZE     64
+
+enum class JournalEntryKind : std::uint8_t
+{
+    NONE = 0,
+    // input command handled by the main loop
+    COMMAND,
+    // speed setpoint applied by a controller
+    SPEED_OUTPUT,
+    // steering setpoint applied by a controller
+    STEERING_OUTPUT
+};
+
+// journal record, stored in the file as is
+struct JournalEntry
+{
+    // entry sequence number starting from 1, 0 marks an empty slot
+    std::uint64_t seq;
+    // CLOCK_MONOTONIC time in nanoseconds
+    std::int64_t time;
+    JournalEntryKind kind;
+    // InputSource of a command
+    std::uint8_t source;
+    // InputEventType of a command
+    std::uint8_t command;
+    std::uint8_t reserved;
+    // target setpoint resulting from a command or value applied by a controller
+    Setpoint setpoint;
+    std::uint16_t reserved2;
+    // name of the controller for output entries, not null-terminated if full
+    char controller[JOURNAL_CONTROLLER_LEN];
+};
+
+static_assert(std::is_trivially_copyable<JournalEntry>::value, "JournalEntry must be trivially copyable");
+static_assert(sizeof(JournalEntry) == 40, "JournalEntry layout changed");
+
+struct JournalHeader
+{
+    char magic[8];
+    std::uint32_t entry_size;
+    std::uint32_t capacity;
+    // sequence number of the last entry written
+    std::atomic<std::uint64_t> seq;
+};
+
+static_assert(sizeof(JournalHeader) <= JOURNAL_HEADER_SIZE, "JournalHeader doesn't fit");
+
+/*
+ * Append-only binary journal of input commands and controller outputs for
+ * offline analysis (see tools/journal2csv.cpp).
+ * The journal is a fixed-size ring of entries in a memory-mapped file,
+ * which is recreated on startup. The journal of the previous run is kept as
+ * <path>.1, so that it survives an automatic restart after a crash.
+ * Recording an entry is a single copy into the mapping and may be done
+ * from any thread without locking; the file is flushed to disk periodically
+ * by a background thread, so entries recorded before a crash of the process
+ * are preserved.
+ */
+class Journal
+{
+public:
+    Journal(const JournalConfig &config);
+    Journal(const Journal &other) = delete;
+    virtual ~Journal();
+
+    bool is_ok() { return _header != nullptr; }
+
+    void record_command(InputSource source, InputEventType command, Setpoint setpoint);
+    void record_output(JournalEntryKind kind, const std::string &controller, Setpoint value);
+    // flush the mapping to disk
+    void sync();
+
+    // read entries of a journal file ordered by sequence number
+    static bool read(const std::string &path, std::vector<JournalEntry> &entries);
+
+protected:
+    void record(JournalEntry &entry);
+    void run();
+
+    JournalConfig _config;
+    void *_map;
+    std::size_t _map_size;
+    JournalHeader *_header;
+    JournalEntry *_entries;
+
+    std::mutex _stop_mutex;
+    std::condition_variable _stop_cond;
+    bool _need_to_stop;
+    std::thread _thread;
+    Log *_log;
+};
+
+} // namespace shipcontrol
+
+#endif // JOURNAL_HPP
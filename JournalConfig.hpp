@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2023 Mikhail Sapozhnikov
+ * Copyright (C) 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -18,37 +18,26 @@
  *
  */
 
-#ifndef GPIO_PWM_THREAD_HPP
-#define GPIO_PWM_THREAD_HPP
+#ifndef JOURNALCONFIG_HPP
+#define JOURNALCONFIG_HPP
 
 #include <string>
 
-#include "Log.hpp"
-#include "SingleThread.hpp"
-
 namespace shipcontrol
 {
 
-class GPIOPWMThread : public SingleThread
+// binary event journal, disabled if path is empty
+struct JournalConfig
 {
-public:
-    GPIOPWMThread(const std::string &chip,
-                  unsigned int engine_line,
-                  unsigned int pwm_period);
-    virtual ~GPIOPWMThread();
-
-    virtual void run();
-
-    void set_pwm_duration(unsigned int pwm_duration);
+    std::string path;
+    // number of entries kept in the ring file
+    unsigned int entries = 65536;
+    // period of flushing the journal to disk in milliseconds
+    unsigned int sync_period = 1000;
 
-protected:
-    const std::string _chip_path;
-    const unsigned int _engine_line;
-    const unsigned int _pwm_period;
-    unsigned int _pwm_duration;
-    Log *_log;
+    bool is_enabled() const { return !path.empty(); }
 };
 
 } // namespace shipcontrol
 
-#endif // GPIO_PWM_THREAD_HPP
+#endif // JOURNALCONFIG_HPP
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LatencyHistogram.hpp"
+
+namespace shipcontrol
+{
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::record(std::uint64_t ns)
+{
+    _buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(ns, std::memory_order_relaxed);
+
+    std::uint64_t max = _max.load(std::memory_order_relaxed);
+    while ((ns > max) && !_max.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : _buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::get_percentile(double fraction) const
+{
+    std::uint64_t count = get_count();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    std::uint64_t threshold = static_cast<std::uint64_t>(fraction * count);
+    if (threshold < fraction * count)
+    {
+        threshold++;
+    }
+    if (threshold == 0)
+    {
+        threshold = 1;
+    }
+
+    std::uint64_t cumulative = 0;
+    for (unsigned int i = 0; i < BUCKETS; i++)
+    {
+        cumulative += _buckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= threshold)
+        {
+            std::uint64_t bound = bucket_upper_bound(i);
+            std::uint64_t max = get_max();
+            return (bound < max) ? bound : max;
+        }
+    }
+
+    return get_max();
+}
+
+unsigned int LatencyHistogram::bucket_index(std::uint64_t ns)
+{
+    if (ns < SUB_BUCKETS)
+    {
+        return static_cast<unsigned int>(ns);
+    }
+
+    unsigned int msb = 63 - __builtin_clzll(ns);
+    unsigned int shift = msb - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<unsigned int>((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+std::uint64_t LatencyHistogram::bucket_upper_bound(unsigned int index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    unsigned int shift = index / SUB_BUCKETS - 1;
+    std::uint64_t lower = static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + ((1ULL << shift) - 1);
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace shipcontrol
+{
+
+/*
+ * Histogram of latencies in nanoseconds with log-linear buckets:
+ * every power of two range is split into 16 buckets, so the relative
+ * error of reported percentiles is within 1/16.
+ * record() is wait-free and doesn't allocate, so it may be called from
+ * time-critical code; it may be read by other threads concurrently.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(std::uint64_t ns);
+    void reset();
+
+    std::uint64_t get_count() const { return _count.load(std::memory_order_relaxed); }
+    std::uint64_t get_max() const { return _max.load(std::memory_order_relaxed); }
+    // sum of all recorded latencies
+    std::uint64_t get_sum() const { return _sum.load(std::memory_order_relaxed); }
+    // upper bound of latency of the given fraction of samples, e.g. 0.99
+    std::uint64_t get_percentile(double fraction) const;
+
+protected:
+    static const unsigned int SUB_BUCKET_BITS = 4;
+    static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const unsigned int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static unsigned int bucket_index(std::uint64_t ns);
+    static std::uint64_t bucket_upper_bound(unsigned int index);
+
+    std::atomic<std::uint64_t> _buckets[BUCKETS];
+    std::atomic<std::uint64_t> _count;
+    std::atomic<std::uint64_t> _sum;
+    std::atomic<std::uint64_t> _max;
+};
+
+} // namespace shipcontrol
+
+#endif // LATENCYHISTOGRAM_HPP
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LatencyStats.hpp"
+
+namespace shipcontrol
+{
+
+LatencyStats::LatencyStats() :
+    _command_time(0),
+    _command_seq(0),
+    _total_seq(0)
+{
+}
+
+void LatencyStats::set_command_time(long long time)
+{
+    if (time != 0)
+    {
+        _command_seq.fetch_add(1, std::memory_order_relaxed);
+    }
+    _command_time.store(time, std::memory_order_relaxed);
+}
+
+bool LatencyStats::claim_total(unsigned long long seq)
+{
+    unsigned long long claimed = _total_seq.load(std::memory_order_relaxed);
+    while (claimed < seq)
+    {
+        if (_total_seq.compare_exchange_weak(claimed, seq, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LatencyStats::record(LatencyStage stage, long long ns)
+{
+    if ((ns < 0) || (stage >= LatencyStage::COUNT))
+    {
+        return;
+    }
+    _stages[static_cast<int>(stage)].record(static_cast<std::uint64_t>(ns));
+}
+
+const char *LatencyStats::stage_name(LatencyStage stage)
+{
+    switch (stage)
+    {
+    case LatencyStage::EVDEV: return "evdev";
+    case LatencyStage::IPC: return "ipc";
+    case LatencyStage::QUEUE: return "queue";
+    case LatencyStage::APPLY: return "apply";
+    case LatencyStage::TOTAL: return "total";
+    default: return "unknown";
+    }
+}
+
+void LatencyStats::log_summary(Log *log) const
+{
+    for (int i = 0; i < static_cast<int>(LatencyStage::COUNT); i++)
+    {
+        const LatencyHistogram &histogram = _stages[i];
+        if (histogram.get_count() == 0)
+        {
+            continue;
+        }
+
+        log->write(LogLevel::NOTICE,
+                   "Latency %s: %llu samples, p50 %llu ns, p99 %llu ns, p99.9 %llu ns, max %llu ns\n",
+                   stage_name(static_cast<LatencyStage>(i)),
+                   static_cast<unsigned long long>(histogram.get_count()),
+                   static_cast<unsigned long long>(histogram.get_percentile(0.5)),
+                   static_cast<unsigned long long>(histogram.get_percentile(0.99)),
+                   static_cast<unsigned long long>(histogram.get_percentile(0.999)),
+                   static_cast<unsigned long long>(histogram.get_max()));
+    }
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LATENCYSTATS_HPP
+#define LATENCYSTATS_HPP
+
+#include <atomic>
+
+#include "LatencyHistogram.hpp"
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+// stages of the input-to-actuation path
+enum class LatencyStage
+{
+    // kernel input event time to its handling by EvdevReader
+    EVDEV = 0,
+    // reception of an IPC request to pushing its command to the input queue
+    IPC,
+    // pushing an input event to the queue to its pop by the main loop
+    QUEUE,
+    // posting a setpoint to a controller to completion of its application
+    APPLY,
+    // input time to completion of the first resulting controller update
+    TOTAL,
+    COUNT
+};
+
+/*
+ * Latency histograms of all stages of the input-to-actuation path.
+ * Recording is wait-free and may be done from any thread.
+ */
+class LatencyStats
+{
+public:
+    LatencyStats();
+    LatencyStats(const LatencyStats &other) = delete;
+
+    // negative latencies (e.g. unknown input time) are ignored
+    void record(LatencyStage stage, long long ns);
+    const LatencyHistogram &get(LatencyStage stage) const { return _stages[static_cast<int>(stage)]; }
+    static const char *stage_name(LatencyStage stage);
+
+    // input time of the command, which is being applied by the main loop,
+    // 0 outside of command handling; a non-zero time starts a new command
+    void set_command_time(long long time);
+    long long get_command_time() const { return _command_time.load(std::memory_order_relaxed); }
+    // sequence number of the last started command
+    unsigned long long get_command_seq() const { return _command_seq.load(std::memory_order_relaxed); }
+    // returns true for the first caller completing the command with the given
+    // sequence number (or a later one), so total latency of a command, which
+    // updates several controllers, is recorded once
+    bool claim_total(unsigned long long seq);
+
+    void log_summary(Log *log) const;
+
+protected:
+    LatencyHistogram _stages[static_cast<int>(LatencyStage::COUNT)];
+    std::atomic<long long> _command_time;
+    std::atomic<unsigned long long> _command_seq;
+    // sequence number of the last command with recorded total latency
+    std::atomic<unsigned long long> _total_seq;
+};
+
+} // namespace shipcontrol
+
+#endif // LATENCYSTATS_HPP
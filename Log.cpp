@@ -69,9 +69,21 @@ void Log::add_backend(LogBackend *backend)
     }
 }
 
+void Log::remove_backend(LogBackend *backend)
+{
+    for (auto it = _backends.begin(); it != _backends.end(); it++)
+    {
+        if (*it == backend)
+        {
+            _backends.erase(it);
+            break;
+        }
+    }
+}
+
 void Log::write(LogLevel level, const char *fmt, ...)
 {
-    if (level >= _level)
+    if (is_enabled(level))
     {
         for (LogBackend *backend : _backends)
         {
@@ -85,7 +97,7 @@ void Log::write(LogLevel level, const char *fmt, ...)
 
 void Log::write(const char *fmt, ...)
 {
-    if (LogLevel::NOTICE >= _level)
+    if (is_enabled(LogLevel::NOTICE))
     {
         for (LogBackend *backend : _backends)
         {
@@ -97,4 +109,28 @@ void Log::write(const char *fmt, ...)
     }
 }
 
+void Log::write_hex(LogLevel level, const char *prefix, const unsigned char *data, std::size_t len)
+{
+    if (is_enabled(level) == false)
+    {
+        return;
+    }
+
+    static const char digits[] = "0123456789abcdef";
+    // longer data is truncated
+    char hex[64 * 5 + 1];
+    std::size_t pos = 0;
+    for (std::size_t i = 0; (i < len) && (pos + 5 < sizeof(hex)); i++)
+    {
+        hex[pos++] = ' ';
+        hex[pos++] = '0';
+        hex[pos++] = 'x';
+        hex[pos++] = digits[data[i] >> 4];
+        hex[pos++] = digits[data[i] & 0x0F];
+    }
+    hex[pos] = '\0';
+
+    write(level, "%s%s\n", prefix, hex);
+}
+
 } // namespace shipcontrol
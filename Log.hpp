@@ -21,9 +21,11 @@
 #ifndef LOG_HPP
 #define LOG_HPP
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <cstdarg>
+#include <cstddef>
 
 namespace shipcontrol
 {
@@ -56,10 +58,15 @@ public:
     static Log *getInstance();
     static void release();
     void add_backend(LogBackend *backend);
+    void remove_backend(LogBackend *backend);
     void write(LogLevel level, const char *fmt, ...);
     // write message with default log level - notice
     void write(const char *fmt, ...);
-    void set_level(LogLevel level) { _level = level; }
+    // write data bytes in hex after the prefix as a single line
+    void write_hex(LogLevel level, const char *prefix, const unsigned char *data, std::size_t len);
+    void set_level(LogLevel level) { _level.store(level, std::memory_order_relaxed); }
+    // cheap check used by logging macros before evaluating message arguments
+    bool is_enabled(LogLevel level) const { return level >= _level.load(std::memory_order_relaxed); }
 
 protected:
     Log();
@@ -70,9 +77,29 @@ protected:
     static Log *_instance;
 
     std::vector<LogBackend *> _backends;
-    LogLevel _level;
+    std::atomic<LogLevel> _level;
 };
 
 } // namespace shipcontrol
 
+/*
+ * Logging front-ends, which check log level before evaluating message
+ * arguments. DEBUG messages are compiled out in release builds (NDEBUG),
+ * define SHIPCONTROL_DEBUG_LOG to keep them.
+ */
+#define LOG_AT(log, level, ...) \
+    do { if ((log)->is_enabled(level)) { (log)->write(level, __VA_ARGS__); } } while (0)
+
+#define LOG_ERROR(log, ...)     LOG_AT(log, shipcontrol::LogLevel::ERROR, __VA_ARGS__)
+#define LOG_NOTICE(log, ...)    LOG_AT(log, shipcontrol::LogLevel::NOTICE, __VA_ARGS__)
+
+#if defined(NDEBUG) && !defined(SHIPCONTROL_DEBUG_LOG)
+#define LOG_DEBUG(log, ...)     do { } while (0)
+#define LOG_DEBUG_HEX(log, prefix, data, len)   do { } while (0)
+#else
+#define LOG_DEBUG(log, ...)     LOG_AT(log, shipcontrol::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_DEBUG_HEX(log, prefix, data, len) \
+    do { if ((log)->is_enabled(shipcontrol::LogLevel::DEBUG)) { (log)->write_hex(shipcontrol::LogLevel::DEBUG, prefix, data, len); } } while (0)
+#endif
+
 #endif // LOG_HPP
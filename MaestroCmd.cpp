@@ -19,12 +19,19 @@
  */
 
 #include "MaestroCmd.hpp"
+#include "Metrics.hpp"
 #include <unistd.h>
 #include <cstring>
+#include <cerrno>
 
 namespace shipcontrol
 {
 
+static Metric *maestro_write_errors = Metrics::counter("shipcontrol_maestro_write_errors_total",
+                                                       "Failed writes of commands to Maestro");
+static Metric *maestro_read_errors = Metrics::counter("shipcontrol_maestro_read_errors_total",
+                                                      "Failed reads of responses from Maestro");
+
 // creates command with up to 3 data bytes
 MaestroCmd::MaestroCmd(int fd, MaestroCmdCode code,
                        unsigned char byte1,
@@ -59,17 +66,13 @@ unsigned char *MaestroCmd::send()
 
     if (write(_fd, (const void *)_cmd, len) == -1)
     {
+        maestro_write_errors->inc();
         _log->write(LogLevel::ERROR,
                    "MaestroCmd couldn't send command to Maestro, error code %d\n",
                    errno);
         goto exit;
     }
-    _log->write(LogLevel::DEBUG, "MaestroCmd sent command: ");
-    for (int i = 0; i < len; i++)
-    {
-        _log->write(LogLevel::DEBUG, "0x%x", _cmd[i]);
-    }
-    _log->write(LogLevel::DEBUG, "\n");
+    LOG_DEBUG_HEX(_log, "MaestroCmd sent command:", _cmd, len);
 
     // calculate response length
     len = rspLen();
@@ -77,17 +80,13 @@ unsigned char *MaestroCmd::send()
     {
         if (read(_fd, (void *)_rsp, len) == -1)
         {
+            maestro_read_errors->inc();
             _log->write(LogLevel::ERROR,
                        "MaestroCmd couldn't read response from Maestro, error code %d\n",
                        errno);
             goto exit;
         }
-        _log->write(LogLevel::DEBUG, "MaestroCmd received response: ");
-        for (int i = 0; i < len; i++)
-        {
-            _log->write(LogLevel::DEBUG, "0x%x ", _rsp[i]);
-        }
-        _log->write(LogLevel::DEBUG, "\n");
+        LOG_DEBUG_HEX(_log, "MaestroCmd received response:", _rsp, len);
     }
 
 exit:
@@ -132,4 +131,110 @@ unsigned char MaestroCmd::rspLen()
     }
 }
 
+MaestroCmdBatch::MaestroCmdBatch(int fd, bool multi_target) :
+    _fd(fd),
+    _multi_target(multi_target),
+    _count(0)
+{
+    _log = Log::getInstance();
+}
+
+MaestroCmdBatch::~MaestroCmdBatch()
+{
+    Log::release();
+}
+
+void MaestroCmdBatch::add_target(unsigned char channel, int value)
+{
+    // keep targets sorted by channel, so that consecutive channels can be merged
+    unsigned int pos = 0;
+    while ((pos < _count) && (_targets[pos].channel < channel))
+    {
+        pos++;
+    }
+
+    if ((pos < _count) && (_targets[pos].channel == channel))
+    {
+        _targets[pos].value = value;
+        return;
+    }
+
+    if (_count == MAESTRO_BATCH_MAX_TARGETS)
+    {
+        _log->write(LogLevel::ERROR, "MaestroCmdBatch is full, target for channel %d dropped\n", channel);
+        return;
+    }
+
+    for (unsigned int i = _count; i > pos; i--)
+    {
+        _targets[i] = _targets[i - 1];
+    }
+    _targets[pos] = Target{channel, value};
+    _count++;
+}
+
+std::size_t MaestroCmdBatch::encode(unsigned char *buf)
+{
+    std::size_t len = 0;
+    unsigned int i = 0;
+
+    while (i < _count)
+    {
+        // length of the run of consecutive channels starting at i
+        unsigned int run = 1;
+        if (_multi_target)
+        {
+            while ((i + run < _count) &&
+                   (_targets[i + run].channel == _targets[i].channel + run))
+            {
+                run++;
+            }
+        }
+
+        if (run > 1)
+        {
+            buf[len++] = static_cast<unsigned char>(MaestroCmdCode::SETMULTIPLETARGETS);
+            buf[len++] = run;
+            buf[len++] = _targets[i].channel;
+        }
+        else
+        {
+            buf[len++] = static_cast<unsigned char>(MaestroCmdCode::SETTARGET);
+            buf[len++] = _targets[i].channel;
+        }
+        for (unsigned int j = i; j < i + run; j++)
+        {
+            buf[len++] = _targets[j].value & 0x7F;
+            buf[len++] = (_targets[j].value >> 7) & 0x7F;
+        }
+        i += run;
+    }
+
+    return len;
+}
+
+bool MaestroCmdBatch::send()
+{
+    unsigned char buf[MAESTRO_BATCH_MAX_TARGETS * MAESTRO_CMD_LEN];
+    std::size_t len = encode(buf);
+    _count = 0;
+
+    if ((_fd == -1) || (len == 0))
+    {
+        return false;
+    }
+
+    if (write(_fd, buf, len) != static_cast<ssize_t>(len))
+    {
+        maestro_write_errors->inc();
+        _log->write(LogLevel::ERROR,
+                   "MaestroCmdBatch couldn't send commands to Maestro, error code %d\n",
+                   errno);
+        return false;
+    }
+    LOG_DEBUG_HEX(_log, "MaestroCmdBatch sent commands:", buf, len);
+
+    return true;
+}
+
 } // namespace shipcontrol
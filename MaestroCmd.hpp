@@ -22,6 +22,7 @@
 #define MAESTRO_CMD_HPP
 
 #include "Log.hpp"
+#include <cstddef>
 
 namespace shipcontrol
 {
@@ -30,6 +31,7 @@ namespace shipcontrol
 enum class MaestroCmdCode : unsigned char
 {
     SETTARGET = 0x84,
+    SETMULTIPLETARGETS = 0x9F,
     SETSPEED = 0x87,
     SETACCEL = 0x89,
     GETPOS = 0x90,
@@ -64,6 +66,45 @@ protected:
     Log *_log;
 };
 
+// maximum number of targets in a single batch
+#define MAESTRO_BATCH_MAX_TARGETS   24
+
+/*
+ * Batch of channel targets sent to Maestro with a single write().
+ * Targets are encoded as back-to-back SETTARGET commands. If multi-target
+ * mode is enabled (Mini Maestro only), runs of consecutive channels are
+ * encoded as a single SETMULTIPLETARGETS command.
+ */
+class MaestroCmdBatch
+{
+public:
+    MaestroCmdBatch(int fd, bool multi_target = false);
+    MaestroCmdBatch(const MaestroCmdBatch &other) = delete;
+    virtual ~MaestroCmdBatch();
+
+    // target in quarter-microseconds, a later target for the same channel replaces the earlier one
+    void add_target(unsigned char channel, int value);
+    // write all targets and clear the batch; returns false if writing has failed
+    bool send();
+    // encode targets into buf of at least MAESTRO_BATCH_MAX_TARGETS * MAESTRO_CMD_LEN bytes,
+    // returns number of bytes
+    std::size_t encode(unsigned char *buf);
+    unsigned int size() { return _count; }
+
+protected:
+    struct Target
+    {
+        unsigned char channel;
+        int value;
+    };
+
+    int _fd;
+    bool _multi_target;
+    Target _targets[MAESTRO_BATCH_MAX_TARGETS];
+    unsigned int _count;
+    Log *_log;
+};
+
 } // namespace shipcontrol
 
 #endif // MAESTRO_CMD_HPP
@@ -62,6 +62,10 @@ public:
     virtual SteeringCalibration get_steering_calibration() = 0;
     virtual int get_direction_high() = 0;
     virtual int get_direction_low() = 0;
+    // SETMULTIPLETARGETS command is supported by Mini Maestro only
+    virtual bool get_multi_target() { return false; }
+    // telemetry polling period in milliseconds, 0 disables polling
+    virtual unsigned int get_telemetry_period() { return 0; }
 };
 
 } // namespace shipcontrol
@@ -35,7 +35,10 @@ namespace shipcontrol
 MaestroController::MaestroController(MaestroConfig &config) :
     _config(config),
     _dev(nullptr),
-    _fd(-1)
+    _fd(-1),
+    _cur_speed(0),
+    _cur_steering(0),
+    _telemetry(nullptr)
 {
     _dev = _config.get_maestro_dev();
     _engines = _config.get_engine_channels();
@@ -43,9 +46,10 @@ MaestroController::MaestroController(MaestroConfig &config) :
     _steering_calibration = _config.get_steering_calibration();
     _dir_high = _config.get_direction_high();
     _dir_low = _config.get_direction_low();
+    _multi_target = _config.get_multi_target();
 
     _log = Log::getInstance();
-    _log->write(LogLevel::DEBUG, "MaestroController ctor\n");
+    LOG_DEBUG(_log, "MaestroController ctor\n");
 
     // open and configure Maestro serial device
     if (_dev != nullptr) {
@@ -53,15 +57,31 @@ MaestroController::MaestroController(MaestroConfig &config) :
 
         if (_fd != -1)
         {
+            // binary protocol in both directions: no CR/NL translation,
+            // no flow control characters, no stripping of the 8th bit
             struct termios options;
             tcgetattr(_fd, &options);
-            options.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
-            options.c_oflag &= ~(ONLCR | OCRNL);
+            cfmakeraw(&options);
             tcsetattr(_fd, TCSANOW, &options);
 
             // set speed to STOP and steering position to STRAIGHT
-            set_speed(SpeedVal::STOP);
-            set_steering(SteeringVal::STRAIGHT);
+            set_speed_setpoint(0);
+            set_steering_setpoint(0);
+
+            if (_config.get_telemetry_period() > 0)
+            {
+                std::vector<int> channels;
+                for (const MaestroEngine &engine : _engines)
+                {
+                    channels.push_back(engine.channel);
+                    if (engine.dir_channel != MaestroEngine::NO_CHANNEL)
+                    {
+                        channels.push_back(engine.dir_channel);
+                    }
+                }
+                channels.insert(channels.end(), _steering.begin(), _steering.end());
+                _telemetry = new MaestroTelemetry(_fd, channels, _config.get_telemetry_period());
+            }
         }
         else
         {
@@ -72,10 +92,15 @@ MaestroController::MaestroController(MaestroConfig &config) :
 
 MaestroController::~MaestroController()
 {
+    if (_telemetry != nullptr)
+    {
+        delete _telemetry;
+    }
+
     if (is_sane() == true)
     {
-        set_speed(SpeedVal::STOP);
-        set_steering(SteeringVal::STRAIGHT);
+        set_speed_setpoint(0);
+        set_steering_setpoint(0);
     }
 
     if (_fd != -1)
@@ -86,43 +111,66 @@ MaestroController::~MaestroController()
     Log::release();
 }
 
-SpeedVal MaestroController::get_speed()
+void MaestroController::start()
+{
+    if (_telemetry != nullptr)
+    {
+        _telemetry->start();
+    }
+}
+
+void MaestroController::stop()
+{
+    if (_telemetry != nullptr)
+    {
+        _telemetry->stop();
+    }
+}
+
+bool MaestroController::get_telemetry(MaestroTelemetryData &data)
+{
+    if (_telemetry == nullptr)
+    {
+        return false;
+    }
+    return _telemetry->get_data(data);
+}
+
+Setpoint MaestroController::get_speed_setpoint()
 {
     if (is_sane() == false)
     {
-        return SpeedVal::STOP;
+        return 0;
     }
 
     return _cur_speed;
 }
 
-void MaestroController::set_speed(SpeedVal speed)
+void MaestroController::set_speed_setpoint(Setpoint speed)
 {
     if (is_sane() == false)
     {
         return;
     }
 
-    // send commands for each engine
-    for (MaestroEngine engine : _engines)
+    speed = clamp_setpoint(speed);
+
+    // targets of all engines are sent with a single write
+    MaestroCmdBatch batch(_fd, _multi_target);
+    for (const MaestroEngine &engine : _engines)
     {
         int val = speed_to_int(speed, engine);
 
-        _log->write(LogLevel::DEBUG,
-                "MaestroController::set_speed(), channel=%d, fwd=%d, value=%d\n",
+        LOG_DEBUG(_log,
+                "MaestroController::set_speed_setpoint(), channel=%d, fwd=%d, value=%d\n",
                 engine.channel, engine.fwd, val);
-        // Pololu protocol requires values in quarter-microseconds
-        val *= 4;
-        unsigned char val0 = val & 0x7F;
-        unsigned char val1 = (val >> 7) & 0x7F;
-        MaestroCmd cmd(_fd, MaestroCmdCode::SETTARGET, engine.channel, val0, val1);
-        cmd.send();
+        batch.add_target(engine.channel, val);
 
         // set rotation direction using separate channel if needed
-        if ((engine.dir_channel != MaestroEngine::NO_CHANNEL) && (speed != SpeedVal::STOP))
+        if ((engine.dir_channel != MaestroEngine::NO_CHANNEL) && (speed != 0))
         {
             int dir_val = 0;
-            if (static_cast<int>(speed) > static_cast<int>(SpeedVal::STOP))
+            if (speed > 0)
             {
                 dir_val = engine.fwd ? _dir_high : _dir_low;
             }
@@ -130,63 +178,125 @@ void MaestroController::set_speed(SpeedVal speed)
             {
                 dir_val = engine.fwd ? _dir_low : _dir_high;
             }
-            _log->write(LogLevel::DEBUG,
-                "MaestroController::set_speed(), direction channel=%d, dir_val=%d\n",
+            LOG_DEBUG(_log,
+                "MaestroController::set_speed_setpoint(), direction channel=%d, dir_val=%d\n",
                 engine.dir_channel, dir_val);
-            dir_val *= 4;
-            unsigned char dir_val0 = dir_val & 0x7F;
-            unsigned char dir_val1 = (dir_val >> 7) & 0x7F;
-            MaestroCmd cmd(_fd, MaestroCmdCode::SETTARGET, engine.dir_channel, dir_val0, dir_val1);
-            cmd.send();
+            batch.add_target(engine.dir_channel, dir_val * 4);
         }
     }
+    batch.send();
 
     _cur_speed = speed;
 }
 
-SteeringVal MaestroController::get_steering()
+Setpoint MaestroController::get_steering_setpoint()
 {
     if (is_sane() == false)
     {
-        return SteeringVal::STRAIGHT;
+        return 0;
     }
 
     return _cur_steering;
 }
 
-void MaestroController::set_steering(SteeringVal steering)
+void MaestroController::set_steering_setpoint(Setpoint steering)
 {
     if (is_sane() == false)
     {
         return;
     }
 
+    steering = clamp_setpoint(steering);
+
     int val = steering_to_int(steering);
-    _log->write(LogLevel::DEBUG, "MaestroController::set_steering(), value=%d\n", val);
-    // Pololu protocol requires values in quarter-microseconds
-    val *= 4;
-    unsigned char val0 = val & 0x7F;
-    unsigned char val1 = (val >> 7) & 0x7F;
+    LOG_DEBUG(_log, "MaestroController::set_steering_setpoint(), value=%d\n", val);
 
-    // send command for each steering servo
+    // targets of all steering servos are sent with a single write
+    MaestroCmdBatch batch(_fd, _multi_target);
     for (int servo : _steering)
     {
-        MaestroCmd cmd(_fd, MaestroCmdCode::SETTARGET, servo, val0, val1);
-        cmd.send();
+        batch.add_target(servo, val);
     }
+    batch.send();
 
     _cur_steering = steering;
 }
 
-int MaestroController::speed_to_int(SpeedVal speed, const MaestroEngine &engine)
+bool MaestroController::set_ramp(const RampConfig &config)
+{
+    if (is_sane() == false)
+    {
+        return false;
+    }
+
+    // direction channels are switched instantly, so engines using them
+    // must be ramped by setpoints passing through stop
+    for (const MaestroEngine &engine : _engines)
+    {
+        if (engine.dir_channel != MaestroEngine::NO_CHANNEL)
+        {
+            return false;
+        }
+    }
+
+    for (const MaestroEngine &engine : _engines)
+    {
+        send_limits(engine.channel, config.speed, engine.step);
+    }
+    for (int servo : _steering)
+    {
+        send_limits(servo, config.steering, _steering_calibration.step);
+    }
+
+    return true;
+}
+
+void MaestroController::send_limits(int channel, const RampLimits &limits, int step)
+{
+    // quarter-microseconds per setpoint unit is step * 4 / SETPOINT_STEP;
+    // Maestro speed limit is given in quarter-microseconds per 10 ms,
+    // acceleration limit in quarter-microseconds per 10 ms per 80 ms; 0 means no limit
+    long long quarter_us = std::abs(step) * 4LL;
+    long long speed = limits.rate * quarter_us / (SETPOINT_STEP * 100LL);
+    long long accel = limits.accel * quarter_us * 8 / (SETPOINT_STEP * 10000LL);
+
+    if ((limits.rate != 0) && (speed == 0))
+    {
+        speed = 1;
+    }
+    if (speed > 0x3FFF)
+    {
+        speed = 0x3FFF;
+    }
+    if ((limits.accel != 0) && (accel == 0))
+    {
+        accel = 1;
+    }
+    if (accel > 255)
+    {
+        accel = 255;
+    }
+
+    LOG_DEBUG(_log, "MaestroController::send_limits(), channel=%d, speed=%d, accel=%d\n",
+            channel, static_cast<int>(speed), static_cast<int>(accel));
+
+    MaestroCmd speed_cmd(_fd, MaestroCmdCode::SETSPEED, channel, speed & 0x7F, (speed >> 7) & 0x7F);
+    speed_cmd.send();
+    MaestroCmd accel_cmd(_fd, MaestroCmdCode::SETACCEL, channel, accel & 0x7F, (accel >> 7) & 0x7F);
+    accel_cmd.send();
+}
+
+int MaestroController::speed_to_int(Setpoint speed, const MaestroEngine &engine)
 {
-    if (speed == SpeedVal::STOP)
+    // Pololu protocol requires values in quarter-microseconds,
+    // calibration step is given in microseconds per 10% of speed
+    if (speed == 0)
     {
-        return engine.stop;
+        return engine.stop * 4;
     }
     else
     {
-        int multiplier = static_cast<int>(speed);
+        int multiplier = speed;
         if (engine.dir_channel != MaestroEngine::NO_CHANNEL)
         {
             // rotation direction is handled through a separate channel
@@ -197,14 +307,13 @@ int MaestroController::speed_to_int(SpeedVal speed, const MaestroEngine &engine)
             multiplier = multiplier * (-1);
         }
 
-        return engine.stop + (multiplier * engine.step);
+        return (engine.stop * 4) + (multiplier * engine.step * 4 / SETPOINT_STEP);
     }
 }
 
-int MaestroController::steering_to_int(SteeringVal steering)
+int MaestroController::steering_to_int(Setpoint steering)
 {
-    int multiplier = static_cast<int>(steering);
-    return _steering_calibration.straight + (multiplier * _steering_calibration.step);
+    return (_steering_calibration.straight * 4) + (steering * _steering_calibration.step * 4 / SETPOINT_STEP);
 }
 
 bool MaestroController::is_sane()
@@ -22,6 +22,7 @@
 #define MAESTRO_CONTROLLER_HPP
 
 #include "MaestroConfig.hpp"
+#include "MaestroTelemetry.hpp"
 #include "ServoController.hpp"
 #include "Log.hpp"
 
@@ -35,13 +36,21 @@ class MaestroController : public ServoController
 public:
     MaestroController(MaestroConfig &config);
     virtual ~MaestroController();
-    SpeedVal get_speed();
-    void set_speed(SpeedVal speed);
-    SteeringVal get_steering();
-    void set_steering(SteeringVal steering);
+    Setpoint get_speed_setpoint();
+    void set_speed_setpoint(Setpoint speed);
+    Setpoint get_steering_setpoint();
+    void set_steering_setpoint(Setpoint steering);
+    bool drives_speed() { return !_engines.empty(); }
+    bool drives_steering() { return !_steering.empty(); }
+    // Maestro ramps targets with per-channel speed and acceleration limits
+    virtual bool set_ramp(const RampConfig &config);
 
-    virtual void start() {}
-    virtual void stop() {}
+    // telemetry polling runs while the controller is started
+    virtual void start();
+    virtual void stop();
+
+    // returns false if telemetry is disabled or hasn't been received yet
+    bool get_telemetry(MaestroTelemetryData &data);
 
 protected:
     MaestroConfig &_config;
@@ -51,13 +60,18 @@ protected:
     SteeringCalibration _steering_calibration;
     int _dir_high;
     int _dir_low;
+    bool _multi_target;
     int _fd;
     Log *_log;
-    SpeedVal _cur_speed;
-    SteeringVal _cur_steering;
+    Setpoint _cur_speed;
+    Setpoint _cur_steering;
+    MaestroTelemetry *_telemetry;
 
-    int speed_to_int(SpeedVal speed, const MaestroEngine &engine);
-    int steering_to_int(SteeringVal steering);
+    // targets in quarter-microseconds
+    int speed_to_int(Setpoint speed, const MaestroEngine &engine);
+    int steering_to_int(Setpoint steering);
+    // send speed and acceleration limits of a channel, step is calibration step in microseconds
+    void send_limits(int channel, const RampLimits &limits, int step);
 
     bool is_sane();
 };
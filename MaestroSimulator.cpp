@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "MaestroSimulator.hpp"
+#include "MaestroCmd.hpp"
+
+namespace shipcontrol
+{
+
+MaestroSimulator::MaestroSimulator() :
+    _master(-1),
+    _slave(-1),
+    _stop_fd(-1),
+    _commands(0),
+    _errors(0),
+    _len(0)
+{
+    for (std::atomic<int> &target : _targets)
+    {
+        target.store(0, std::memory_order_relaxed);
+    }
+    _log = Log::getInstance();
+}
+
+MaestroSimulator::~MaestroSimulator()
+{
+    stop();
+    Log::release();
+}
+
+bool MaestroSimulator::start()
+{
+    if (_thread.joinable())
+    {
+        return true;
+    }
+
+    _master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    char name[64];
+    if ((_master == -1) || (grantpt(_master) == -1) || (unlockpt(_master) == -1) ||
+        (ptsname_r(_master, name, sizeof(name)) != 0))
+    {
+        _log->write(LogLevel::ERROR, "MaestroSimulator failed to open pseudo terminal, error code %d\n", errno);
+        stop();
+        return false;
+    }
+
+    // terminal settings are left at their defaults, like those of a freshly
+    // plugged Maestro, the controller must configure the device itself
+    _slave = open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (_slave == -1)
+    {
+        _log->write(LogLevel::ERROR, "MaestroSimulator failed to open %s, error code %d\n", name, errno);
+        stop();
+        return false;
+    }
+
+    _stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stop_fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "MaestroSimulator failed to create eventfd, error code %d\n", errno);
+        stop();
+        return false;
+    }
+
+    _dev = name;
+    _len = 0;
+    _thread = std::thread(&MaestroSimulator::run, this);
+    _log->write(LogLevel::NOTICE, "MaestroSimulator is listening on %s\n", _dev.c_str());
+    return true;
+}
+
+void MaestroSimulator::stop()
+{
+    if (_thread.joinable())
+    {
+        std::uint64_t val = 1;
+        if (write(_stop_fd, &val, sizeof(val)) == -1)
+        {
+            _log->write(LogLevel::ERROR, "MaestroSimulator failed to signal stop, error code %d\n", errno);
+        }
+        _thread.join();
+    }
+
+    int *fds[] = { &_stop_fd, &_slave, &_master };
+    for (int *fd : fds)
+    {
+        if (*fd != -1)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+int MaestroSimulator::get_target(unsigned int channel)
+{
+    if (channel >= MAESTRO_SIM_CHANNELS)
+    {
+        return 0;
+    }
+    return _targets[channel].load(std::memory_order_relaxed);
+}
+
+void MaestroSimulator::run()
+{
+    pollfd fds[2];
+    fds[0].fd = _stop_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = _master;
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            _log->write(LogLevel::ERROR, "MaestroSimulator poll failed, error code %d\n", errno);
+            break;
+        }
+
+        if (fds[0].revents != 0)
+        {
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+        {
+            ssize_t len = read(_master, _buf + _len, sizeof(_buf) - _len);
+            if (len <= 0)
+            {
+                continue;
+            }
+            _len += len;
+
+            std::size_t consumed = decode();
+            _len -= consumed;
+            std::memmove(_buf, _buf + consumed, _len);
+        }
+    }
+}
+
+std::size_t MaestroSimulator::decode()
+{
+    std::size_t pos = 0;
+
+    while (pos < _len)
+    {
+        const unsigned char *cmd = _buf + pos;
+        std::size_t avail = _len - pos;
+        std::size_t cmd_len = 0;
+
+        switch (static_cast<MaestroCmdCode>(cmd[0]))
+        {
+        case MaestroCmdCode::SETTARGET:
+        case MaestroCmdCode::SETSPEED:
+        case MaestroCmdCode::SETACCEL:
+            cmd_len = 4;
+            break;
+        case MaestroCmdCode::SETMULTIPLETARGETS:
+            if (avail < 3)
+            {
+                return pos;
+            }
+            if ((cmd[1] == 0) || (cmd[2] + cmd[1] > MAESTRO_SIM_CHANNELS))
+            {
+                cmd_len = 0;
+                break;
+            }
+            cmd_len = 3 + 2 * cmd[1];
+            break;
+        case MaestroCmdCode::GETPOS:
+            cmd_len = 2;
+            break;
+        case MaestroCmdCode::GETMOVINGSTATE:
+        case MaestroCmdCode::GETERRORS:
+        case MaestroCmdCode::GOHOME:
+            cmd_len = 1;
+            break;
+        default:
+            break;
+        }
+
+        if (cmd_len == 0)
+        {
+            // skip the byte and try to resynchronize on the next one
+            _errors.fetch_add(1, std::memory_order_relaxed);
+            pos++;
+            continue;
+        }
+        if (avail < cmd_len)
+        {
+            // wait for the rest of the command
+            return pos;
+        }
+
+        switch (static_cast<MaestroCmdCode>(cmd[0]))
+        {
+        case MaestroCmdCode::SETTARGET:
+            if (cmd[1] < MAESTRO_SIM_CHANNELS)
+            {
+                _targets[cmd[1]].store(cmd[2] | (cmd[3] << 7), std::memory_order_relaxed);
+            }
+            break;
+        case MaestroCmdCode::SETMULTIPLETARGETS:
+            for (unsigned int i = 0; i < cmd[1]; i++)
+            {
+                _targets[cmd[2] + i].store(cmd[3 + 2 * i] | (cmd[4 + 2 * i] << 7), std::memory_order_relaxed);
+            }
+            break;
+        case MaestroCmdCode::GETPOS:
+        {
+            int position = get_target(cmd[1]);
+            unsigned char rsp[2] = { static_cast<unsigned char>(position & 0xFF),
+                                     static_cast<unsigned char>((position >> 8) & 0xFF) };
+            reply(rsp, sizeof(rsp));
+            break;
+        }
+        case MaestroCmdCode::GETMOVINGSTATE:
+        {
+            // channels never move, targets are reached immediately
+            unsigned char rsp[1] = { 0 };
+            reply(rsp, sizeof(rsp));
+            break;
+        }
+        case MaestroCmdCode::GETERRORS:
+        {
+            unsigned char rsp[2] = { 0, 0 };
+            reply(rsp, sizeof(rsp));
+            break;
+        }
+        case MaestroCmdCode::GOHOME:
+            for (std::atomic<int> &target : _targets)
+            {
+                target.store(0, std::memory_order_relaxed);
+            }
+            break;
+        default:
+            // speed and acceleration limits have no effect
+            break;
+        }
+
+        _commands.fetch_add(1, std::memory_order_relaxed);
+        pos += cmd_len;
+    }
+
+    return pos;
+}
+
+void MaestroSimulator::reply(const unsigned char *data, std::size_t len)
+{
+    if (write(_master, data, len) != static_cast<ssize_t>(len))
+    {
+        _log->write(LogLevel::ERROR, "MaestroSimulator failed to send response, error code %d\n", errno);
+    }
+}
+
+} // namespace shipcontrol
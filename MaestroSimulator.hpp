@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MAESTROSIMULATOR_HPP
+#define MAESTROSIMULATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "MaestroConfig.hpp"
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+// number of channels of the largest Mini Maestro
+#define MAESTRO_SIM_CHANNELS    24
+// max length of a single command (SETMULTIPLETARGETS for all channels)
+#define MAESTRO_SIM_CMD_MAX     (3 + 2 * MAESTRO_SIM_CHANNELS)
+
+/*
+ * Simulated Pololu Maestro for running without hardware.
+ * MaestroController uses the slave side of a pseudo terminal as the Maestro
+ * device. Commands of the compact protocol are decoded by a separate thread
+ * and answered like a real Maestro would. Channels reach their targets
+ * immediately, so position queries return the latest targets.
+ */
+class MaestroSimulator
+{
+public:
+    MaestroSimulator();
+    MaestroSimulator(const MaestroSimulator &other) = delete;
+    virtual ~MaestroSimulator();
+
+    // returns false if the pseudo terminal can't be opened
+    bool start();
+    void stop();
+
+    // path to the Maestro device, empty until started
+    const std::string &get_dev() { return _dev; }
+    // latest target of the channel in quarter-microseconds, 0 if not set
+    int get_target(unsigned int channel);
+    // number of decoded commands
+    std::uint64_t get_commands() { return _commands.load(std::memory_order_relaxed); }
+    // number of bytes not recognized as commands
+    std::uint64_t get_errors() { return _errors.load(std::memory_order_relaxed); }
+
+protected:
+    void run();
+    // decodes complete commands at the beginning of _buf, returns number of consumed bytes
+    std::size_t decode();
+    void reply(const unsigned char *data, std::size_t len);
+
+    int _master;
+    // kept open so that the terminal isn't hung up between controller sessions
+    int _slave;
+    // eventfd used to wake up the thread on stop()
+    int _stop_fd;
+    std::string _dev;
+    std::thread _thread;
+    std::atomic<int> _targets[MAESTRO_SIM_CHANNELS];
+    std::atomic<std::uint64_t> _commands;
+    std::atomic<std::uint64_t> _errors;
+    // received bytes which don't make a complete command yet
+    unsigned char _buf[MAESTRO_SIM_CMD_MAX * 4];
+    std::size_t _len;
+    Log *_log;
+};
+
+// Maestro configuration with the device replaced by the simulator
+class MaestroSimulatorConfig : public MaestroConfig
+{
+public:
+    MaestroSimulatorConfig(MaestroConfig &config, const std::string &dev) : _config(config), _dev(dev) {}
+
+    virtual const char *get_maestro_dev() { return _dev.c_str(); }
+    virtual std::vector<MaestroEngine> get_engine_channels() { return _config.get_engine_channels(); }
+    virtual std::vector<int> get_steering_channels() { return _config.get_steering_channels(); }
+    virtual SteeringCalibration get_steering_calibration() { return _config.get_steering_calibration(); }
+    virtual int get_direction_high() { return _config.get_direction_high(); }
+    virtual int get_direction_low() { return _config.get_direction_low(); }
+    virtual bool get_multi_target() { return _config.get_multi_target(); }
+    virtual unsigned int get_telemetry_period() { return _config.get_telemetry_period(); }
+
+protected:
+    MaestroConfig &_config;
+    std::string _dev;
+};
+
+} // namespace shipcontrol
+
+#endif // MAESTROSIMULATOR_HPP
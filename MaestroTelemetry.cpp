@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cerrno>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "MaestroTelemetry.hpp"
+#include "Clock.hpp"
+
+namespace shipcontrol
+{
+
+MaestroTelemetry::MaestroTelemetry(int fd, const std::vector<int> &channels, unsigned int period_ms) :
+    _fd(fd),
+    _period(period_ms * 1000000LL),
+    _thread(nullptr),
+    _need_to_stop(false),
+    _query_count(0),
+    _next_query(0),
+    _rsp_len(0),
+    _timed_out(false),
+    _cycle{},
+    _data{}
+{
+    _log = Log::getInstance();
+
+    for (int channel : channels)
+    {
+        if ((channel < 0) || (_cycle.channel_count == MAESTRO_TELEMETRY_MAX_CHANNELS))
+        {
+            continue;
+        }
+        _cycle.channels[_cycle.channel_count++] = channel;
+    }
+}
+
+MaestroTelemetry::~MaestroTelemetry()
+{
+    stop();
+    Log::release();
+}
+
+void MaestroTelemetry::start()
+{
+    if ((_thread == nullptr) && (_fd != -1))
+    {
+        _need_to_stop = false;
+        _thread = new std::thread(&MaestroTelemetry::run, this);
+    }
+}
+
+void MaestroTelemetry::stop()
+{
+    if (_thread != nullptr)
+    {
+        _need_to_stop = true;
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+}
+
+bool MaestroTelemetry::get_data(MaestroTelemetryData &data)
+{
+    std::lock_guard<std::mutex> lock(_data_mutex);
+    if (_data.polls == 0)
+    {
+        return false;
+    }
+    data = _data;
+    return true;
+}
+
+bool MaestroTelemetry::send_queries()
+{
+    unsigned char buf[MAESTRO_TELEMETRY_MAX_CHANNELS * 2 + 2];
+    std::size_t len = 0;
+
+    _query_count = 0;
+    for (unsigned int i = 0; i < _cycle.channel_count; i++)
+    {
+        _queries[_query_count++] = Query{MaestroCmdCode::GETPOS, i};
+        buf[len++] = static_cast<unsigned char>(MaestroCmdCode::GETPOS);
+        buf[len++] = _cycle.channels[i];
+    }
+    _queries[_query_count++] = Query{MaestroCmdCode::GETMOVINGSTATE, 0};
+    buf[len++] = static_cast<unsigned char>(MaestroCmdCode::GETMOVINGSTATE);
+    _queries[_query_count++] = Query{MaestroCmdCode::GETERRORS, 0};
+    buf[len++] = static_cast<unsigned char>(MaestroCmdCode::GETERRORS);
+    _next_query = 0;
+    _rsp_len = 0;
+
+    if (write(_fd, buf, len) != static_cast<ssize_t>(len))
+    {
+        _log->write(LogLevel::ERROR, "MaestroTelemetry couldn't send queries, error code %d\n", errno);
+        drop_pending();
+        return false;
+    }
+
+    return true;
+}
+
+void MaestroTelemetry::feed(const unsigned char *data, std::size_t len)
+{
+    for (std::size_t i = 0; i < len; i++)
+    {
+        if (_next_query == _query_count)
+        {
+            // reply to nothing, ignore
+            continue;
+        }
+
+        const Query &query = _queries[_next_query];
+        _rsp[_rsp_len++] = data[i];
+
+        switch (query.code)
+        {
+        case MaestroCmdCode::GETPOS:
+            if (_rsp_len == 2)
+            {
+                _cycle.positions[query.index] = _rsp[0] | (_rsp[1] << 8);
+                _rsp_len = 0;
+                _next_query++;
+            }
+            break;
+        case MaestroCmdCode::GETERRORS:
+            if (_rsp_len == 2)
+            {
+                _cycle.errors = _rsp[0] | (_rsp[1] << 8);
+                _rsp_len = 0;
+                _next_query++;
+            }
+            break;
+        case MaestroCmdCode::GETMOVINGSTATE:
+        default:
+            _cycle.moving = (_rsp[0] != 0);
+            _rsp_len = 0;
+            _next_query++;
+            break;
+        }
+    }
+}
+
+void MaestroTelemetry::drop_pending()
+{
+    _query_count = 0;
+    _next_query = 0;
+    _rsp_len = 0;
+}
+
+void MaestroTelemetry::run()
+{
+    LOG_DEBUG(_log, "MaestroTelemetry::run()\n");
+
+    long long next_cycle = monotonic_now();
+    long long deadline = 0;
+
+    while (_need_to_stop == false)
+    {
+        long long now = monotonic_now();
+
+        if ((_query_count == 0) && (now >= next_cycle))
+        {
+            next_cycle += _period;
+            if (next_cycle <= now)
+            {
+                next_cycle = now + _period;
+            }
+            if (send_queries())
+            {
+                deadline = now + MAESTRO_TELEMETRY_TIMEOUT * 1000000LL;
+            }
+        }
+
+        if ((_query_count != 0) && (now >= deadline))
+        {
+            // replies are stale, drop them so that the next cycle starts in sync;
+            // only the first timeout in a row is logged, the rest are counted
+            if (_timed_out == false)
+            {
+                _log->write(LogLevel::NOTICE, "MaestroTelemetry timed out waiting for %u replies\n",
+                            _query_count - _next_query);
+                _timed_out = true;
+            }
+            drop_pending();
+            tcflush(_fd, TCIFLUSH);
+            _cycle.timeouts++;
+            {
+                std::lock_guard<std::mutex> lock(_data_mutex);
+                _data.timeouts = _cycle.timeouts;
+            }
+            continue;
+        }
+
+        // wait for replies or for the next cycle, wake up regularly to check the stop flag
+        long long wait_until = (_query_count != 0) ? deadline : next_cycle;
+        long long timeout_ms = (wait_until - now + 999999) / 1000000;
+        if (timeout_ms > 50)
+        {
+            timeout_ms = 50;
+        }
+
+        pollfd pfd{_fd, POLLIN, 0};
+        int ret = poll(&pfd, 1, static_cast<int>(timeout_ms));
+        if ((ret < 0) && (errno != EINTR))
+        {
+            _log->write(LogLevel::ERROR, "MaestroTelemetry poll failed, error code %d, stopping\n", errno);
+            break;
+        }
+        if ((ret > 0) && ((pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0))
+        {
+            // the device is gone (e.g. unplugged), it won't produce replies anymore
+            _log->write(LogLevel::ERROR, "MaestroTelemetry device hung up (revents 0x%x), stopping\n",
+                        pfd.revents);
+            break;
+        }
+        if ((ret <= 0) || ((pfd.revents & POLLIN) == 0))
+        {
+            continue;
+        }
+
+        unsigned char buf[64];
+        ssize_t len = read(_fd, buf, sizeof(buf));
+        if (len <= 0)
+        {
+            continue;
+        }
+        feed(buf, len);
+
+        if ((_query_count != 0) && (_next_query == _query_count))
+        {
+            drop_pending();
+            _timed_out = false;
+            _cycle.polls++;
+            _cycle.updated = monotonic_now();
+            if (_cycle.errors != 0)
+            {
+                _log->write(LogLevel::NOTICE, "Maestro reported errors 0x%x\n", _cycle.errors);
+            }
+
+            std::lock_guard<std::mutex> lock(_data_mutex);
+            _data = _cycle;
+        }
+    }
+
+    LOG_DEBUG(_log, "MaestroTelemetry stopping\n");
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MAESTROTELEMETRY_HPP
+#define MAESTROTELEMETRY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MaestroCmd.hpp"
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+// maximum number of channels polled by MaestroTelemetry
+#define MAESTRO_TELEMETRY_MAX_CHANNELS  MAESTRO_BATCH_MAX_TARGETS
+// max time to wait for all responses of a polling cycle, milliseconds
+#define MAESTRO_TELEMETRY_TIMEOUT       100
+
+// snapshot of Maestro state
+struct MaestroTelemetryData
+{
+    unsigned int channel_count;
+    unsigned char channels[MAESTRO_TELEMETRY_MAX_CHANNELS];
+    // channel positions in quarter-microseconds
+    std::uint16_t positions[MAESTRO_TELEMETRY_MAX_CHANNELS];
+    // true if any of the channels is still moving toward its target
+    bool moving;
+    // error bits reported by GETERRORS
+    std::uint16_t errors;
+    // completed polling cycles and cycles dropped because of timeout
+    std::uint64_t polls;
+    std::uint64_t timeouts;
+    // CLOCK_MONOTONIC time of the last update in nanoseconds
+    long long updated;
+};
+
+/*
+ * Periodic poller of Maestro channel positions, moving state and errors.
+ * All queries of a polling cycle are sent with a single write and responses
+ * are matched to them in FIFO order, as Maestro answers in the order of
+ * requests. The Maestro fd is only read when poll() reports data, so the
+ * poller never blocks on a missing reply; if the cycle isn't complete within
+ * MAESTRO_TELEMETRY_TIMEOUT, its pending replies are considered stale and
+ * dropped together with any unread input. If the device hangs up or poll()
+ * fails, the poller logs an error and stops.
+ * Target commands may be written to the same fd from other threads, as they
+ * don't produce replies.
+ */
+class MaestroTelemetry
+{
+public:
+    MaestroTelemetry(int fd, const std::vector<int> &channels, unsigned int period_ms);
+    MaestroTelemetry(const MaestroTelemetry &other) = delete;
+    virtual ~MaestroTelemetry();
+
+    void start();
+    void stop();
+
+    // returns false if no polling cycle has been completed yet
+    bool get_data(MaestroTelemetryData &data);
+
+protected:
+    struct Query
+    {
+        MaestroCmdCode code;
+        // index of the channel in _data.channels for GETPOS
+        unsigned int index;
+    };
+
+    void run();
+    // send queries of a new polling cycle
+    bool send_queries();
+    // consume received bytes, completing queries in FIFO order
+    void feed(const unsigned char *data, std::size_t len);
+    void drop_pending();
+
+    int _fd;
+    long long _period;
+    std::thread *_thread;
+    std::atomic<bool> _need_to_stop;
+
+    // state of the polling thread
+    Query _queries[MAESTRO_TELEMETRY_MAX_CHANNELS + 2];
+    unsigned int _query_count;
+    unsigned int _next_query;
+    unsigned char _rsp[MAESTRO_RSP_LEN];
+    unsigned int _rsp_len;
+    // set after a timeout until the next completed cycle
+    bool _timed_out;
+    MaestroTelemetryData _cycle;
+
+    // published snapshot
+    std::mutex _data_mutex;
+    MaestroTelemetryData _data;
+
+    Log *_log;
+};
+
+} // namespace shipcontrol
+
+#endif // MAESTROTELEMETRY_HPP
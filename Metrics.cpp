@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Metrics.hpp"
+
+namespace shipcontrol
+{
+
+Metric::Metric(MetricType type, const std::string &labels) :
+    _labels(labels),
+    _value(0)
+{
+    if (type == MetricType::SUMMARY)
+    {
+        _histogram.reset(new LatencyHistogram());
+    }
+}
+
+Metric *Metrics::counter(const std::string &name, const std::string &help, const std::string &labels)
+{
+    return get(MetricType::COUNTER, name, help, labels);
+}
+
+Metric *Metrics::gauge(const std::string &name, const std::string &help, const std::string &labels)
+{
+    return get(MetricType::GAUGE, name, help, labels);
+}
+
+Metric *Metrics::summary(const std::string &name, const std::string &help, const std::string &labels)
+{
+    return get(MetricType::SUMMARY, name, help, labels);
+}
+
+// registry is created on first use, so that metrics may be registered during static initialization
+std::mutex &Metrics::get_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<std::unique_ptr<Metrics::Family>> &Metrics::get_families()
+{
+    static std::vector<std::unique_ptr<Family>> families;
+    return families;
+}
+
+Metric *Metrics::get(MetricType type, const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(get_mutex());
+    std::vector<std::unique_ptr<Family>> &families = get_families();
+
+    Family *family = nullptr;
+    for (auto &item : families)
+    {
+        if (item->name == name)
+        {
+            family = item.get();
+            break;
+        }
+    }
+    if (family == nullptr)
+    {
+        families.emplace_back(new Family{name, help, type, {}});
+        family = families.back().get();
+    }
+
+    for (auto &metric : family->metrics)
+    {
+        if (metric->get_labels() == labels)
+        {
+            return metric.get();
+        }
+    }
+
+    // the type of the family is defined by its first metric
+    family->metrics.emplace_back(new Metric(family->type, labels));
+    return family->metrics.back().get();
+}
+
+std::string Metrics::format()
+{
+    std::lock_guard<std::mutex> lock(get_mutex());
+
+    std::string out;
+    for (auto &family : get_families())
+    {
+        const char *type = "counter";
+        if (family->type == MetricType::GAUGE)
+        {
+            type = "gauge";
+        }
+        else if (family->type == MetricType::SUMMARY)
+        {
+            type = "summary";
+        }
+
+        out += "# HELP " + family->name + " " + family->help + "\n";
+        out += "# TYPE " + family->name + " " + type + "\n";
+        for (auto &metric : family->metrics)
+        {
+            format_metric(out, *family, *metric);
+        }
+    }
+
+    return out;
+}
+
+void Metrics::format_metric(std::string &out, const Family &family, const Metric &metric)
+{
+    const std::string &labels = metric.get_labels();
+    std::string braced = labels.empty() ? "" : "{" + labels + "}";
+
+    if (family.type != MetricType::SUMMARY)
+    {
+        out += family.name + braced + " " + std::to_string(metric.get()) + "\n";
+        return;
+    }
+
+    const LatencyHistogram *histogram = metric.get_histogram();
+    const char *quantiles[] = { "0.5", "0.9", "0.99", "0.999" };
+    const double fractions[] = { 0.5, 0.9, 0.99, 0.999 };
+    for (int i = 0; i < 4; i++)
+    {
+        out += family.name + "{" + labels + (labels.empty() ? "" : ",") +
+               "quantile=\"" + quantiles[i] + "\"} " +
+               std::to_string(histogram->get_percentile(fractions[i])) + "\n";
+    }
+    out += family.name + "_sum" + braced + " " + std::to_string(histogram->get_sum()) + "\n";
+    out += family.name + "_count" + braced + " " + std::to_string(histogram->get_count()) + "\n";
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+
+namespace shipcontrol
+{
+
+enum class MetricType
+{
+    COUNTER,
+    GAUGE,
+    // latency distribution, exported with quantiles, sum and count
+    SUMMARY
+};
+
+/*
+ * Single metric of the registry (one combination of name and labels).
+ * Updates are lock-free and may be done from any thread.
+ */
+class Metric
+{
+public:
+    Metric(MetricType type, const std::string &labels);
+    Metric(const Metric &other) = delete;
+
+    void inc(std::int64_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+    void dec(std::int64_t n = 1) { _value.fetch_sub(n, std::memory_order_relaxed); }
+    void set(std::int64_t value) { _value.store(value, std::memory_order_relaxed); }
+    std::int64_t get() const { return _value.load(std::memory_order_relaxed); }
+    // summary metrics only
+    void record(std::uint64_t ns) { _histogram->record(ns); }
+    const LatencyHistogram *get_histogram() const { return _histogram.get(); }
+
+    const std::string &get_labels() const { return _labels; }
+
+protected:
+    std::string _labels;
+    std::atomic<std::int64_t> _value;
+    std::unique_ptr<LatencyHistogram> _histogram;
+};
+
+/*
+ * Process-wide registry of metrics.
+ * Modules look up their metrics once (registration is serialized by a mutex)
+ * and keep the pointers, metrics are never destroyed.
+ * Labels are given in exposition format, e.g. source="evdev".
+ * Registering an existing name and labels returns the existing metric.
+ */
+class Metrics
+{
+public:
+    static Metric *counter(const std::string &name, const std::string &help, const std::string &labels = "");
+    static Metric *gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+    static Metric *summary(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    // all metrics in Prometheus text exposition format
+    static std::string format();
+
+protected:
+    struct Family
+    {
+        std::string name;
+        std::string help;
+        MetricType type;
+        std::vector<std::unique_ptr<Metric>> metrics;
+    };
+
+    static Metric *get(MetricType type, const std::string &name, const std::string &help, const std::string &labels);
+    static void format_metric(std::string &out, const Family &family, const Metric &metric);
+
+    static std::mutex &get_mutex();
+    static std::vector<std::unique_ptr<Family>> &get_families();
+};
+
+} // namespace shipcontrol
+
+#endif // METRICS_HPP
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "MetricsListener.hpp"
+#include "Metrics.hpp"
+
+namespace shipcontrol
+{
+
+// max time of sending metrics to a client, milliseconds
+#define METRICS_SEND_TIMEOUT    1000
+
+MetricsListener::MetricsListener(const std::string &socket_name) :
+    _socket_name(socket_name),
+    _fd(-1),
+    _stop_fd(-1)
+{
+    _log = Log::getInstance();
+}
+
+MetricsListener::~MetricsListener()
+{
+    stop();
+    Log::release();
+}
+
+bool MetricsListener::start()
+{
+    if (_thread.joinable())
+    {
+        return true;
+    }
+
+    _fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (_fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "MetricsListener failed to open socket, error code %d\n", errno);
+        return false;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, _socket_name.c_str(), sizeof(addr.sun_path) - 1);
+    // remove the socket left by a previous run
+    unlink(addr.sun_path);
+
+    if ((bind(_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(sockaddr_un)) == -1) ||
+        (listen(_fd, SOMAXCONN) == -1))
+    {
+        _log->write(LogLevel::ERROR, "MetricsListener failed to listen socket %s, error code %d\n",
+                    _socket_name.c_str(), errno);
+        close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    _stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stop_fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "MetricsListener failed to create eventfd, error code %d\n", errno);
+        close(_fd);
+        _fd = -1;
+        unlink(_socket_name.c_str());
+        return false;
+    }
+
+    _thread = std::thread(&MetricsListener::run, this);
+    return true;
+}
+
+void MetricsListener::stop()
+{
+    if (_thread.joinable())
+    {
+        std::uint64_t val = 1;
+        if (write(_stop_fd, &val, sizeof(val)) == -1)
+        {
+            _log->write(LogLevel::ERROR, "MetricsListener failed to signal stop, error code %d\n", errno);
+        }
+        _thread.join();
+    }
+
+    if (_stop_fd != -1)
+    {
+        close(_stop_fd);
+        _stop_fd = -1;
+    }
+    if (_fd != -1)
+    {
+        close(_fd);
+        _fd = -1;
+        unlink(_socket_name.c_str());
+    }
+}
+
+void MetricsListener::run()
+{
+    pollfd fds[2];
+    fds[0].fd = _stop_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = _fd;
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            _log->write(LogLevel::ERROR, "MetricsListener poll failed, error code %d\n", errno);
+            break;
+        }
+
+        if (fds[0].revents != 0)
+        {
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+        {
+            int client = accept4(_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client != -1)
+            {
+                serve_client(client);
+                close(client);
+            }
+        }
+    }
+}
+
+void MetricsListener::serve_client(int fd)
+{
+    // a stuck scraper must not block the listener forever
+    timeval tv;
+    tv.tv_sec = METRICS_SEND_TIMEOUT / 1000;
+    tv.tv_usec = (METRICS_SEND_TIMEOUT % 1000) * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    std::string text = Metrics::format();
+    std::size_t sent = 0;
+    while (sent < text.size())
+    {
+        ssize_t len = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (len == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_DEBUG(_log, "MetricsListener failed to send metrics, error code %d\n", errno);
+            return;
+        }
+        sent += len;
+    }
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef METRICSLISTENER_HPP
+#define METRICSLISTENER_HPP
+
+#include <string>
+#include <thread>
+
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Unix socket server exporting metrics (see Metrics.hpp) in text exposition
+ * format. Every accepted connection is sent the current metrics and closed,
+ * so a local scraper simply reads the socket until EOF. The socket is served
+ * by its own thread, separately from the control socket.
+ */
+class MetricsListener
+{
+public:
+    MetricsListener(const std::string &socket_name);
+    MetricsListener(const MetricsListener &other) = delete;
+    virtual ~MetricsListener();
+
+    // returns false if the socket can't be opened
+    bool start();
+    void stop();
+
+protected:
+    void run();
+    void serve_client(int fd);
+
+    std::string _socket_name;
+    int _fd;
+    // eventfd used to wake up the thread on stop()
+    int _stop_fd;
+    std::thread _thread;
+    Log *_log;
+};
+
+} // namespace shipcontrol
+
+#endif // METRICSLISTENER_HPP
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "QueryCache.hpp"
+#include "json.hpp"
+#include <cstring>
+
+using json = nlohmann::json;
+
+namespace shipcontrol
+{
+
+QueryCache::QueryCache()
+: _seq(0),
+  _len(0),
+  _setpoints(0)
+{
+    for (auto &word : _data)
+    {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+void QueryCache::publish(Setpoint speed, Setpoint steering)
+{
+    json j;
+
+    j["speed"] = ServoController::speed_name(ServoController::setpoint_to_speed(speed));
+    j["steering"] = ServoController::steering_name(ServoController::setpoint_to_steering(steering));
+
+    std::string resp = j.dump();
+    std::uint64_t words[WORDS];
+    std::uint32_t len = 0;
+    // responses which don't fit are not cached, readers fall back to building them
+    if (resp.size() <= QUERY_CACHE_SIZE)
+    {
+        std::memset(words, 0, sizeof(words));
+        std::memcpy(words, resp.data(), resp.size());
+        len = resp.size();
+    }
+
+    std::uint32_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < WORDS; i++)
+    {
+        _data[i].store(words[i], std::memory_order_relaxed);
+    }
+    _len.store(len, std::memory_order_relaxed);
+    _setpoints.store(static_cast<std::uint16_t>(speed) |
+                     (static_cast<std::uint32_t>(static_cast<std::uint16_t>(steering)) << 16),
+                     std::memory_order_relaxed);
+
+    _seq.store(seq + 2, std::memory_order_release);
+}
+
+bool QueryCache::read(std::string &out) const
+{
+    std::uint64_t words[WORDS];
+    std::uint32_t len;
+    std::uint32_t seq;
+
+    while (true)
+    {
+        seq = _seq.load(std::memory_order_acquire);
+        if (seq & 1)
+        {
+            // update in progress
+            continue;
+        }
+
+        len = _len.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < WORDS; i++)
+        {
+            words[i] = _data[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) == seq)
+        {
+            break;
+        }
+    }
+
+    if (len == 0)
+    {
+        return false;
+    }
+
+    out.assign(reinterpret_cast<const char *>(words), len);
+    return true;
+}
+
+bool QueryCache::read_setpoints(Setpoint &speed, Setpoint &steering) const
+{
+    std::uint32_t setpoints;
+    std::uint32_t seq;
+
+    while (true)
+    {
+        seq = _seq.load(std::memory_order_acquire);
+        if (seq & 1)
+        {
+            // update in progress
+            continue;
+        }
+
+        setpoints = _setpoints.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) == seq)
+        {
+            break;
+        }
+    }
+
+    if (seq == 0)
+    {
+        return false;
+    }
+
+    speed = static_cast<Setpoint>(static_cast<std::uint16_t>(setpoints & 0xFFFF));
+    steering = static_cast<Setpoint>(static_cast<std::uint16_t>(setpoints >> 16));
+    return true;
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef QUERYCACHE_HPP
+#define QUERYCACHE_HPP
+
+#include "ServoController.hpp" // included for Setpoint definition
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace shipcontrol
+{
+
+// max size of serialized query response in bytes
+#define QUERY_CACHE_SIZE    128
+
+/*
+ * Serialized query response, regenerated by the writer only when ship
+ * status changes and copied by readers without locking.
+ *
+ * The snapshot is protected by a sequence lock: the writer makes the sequence
+ * number odd while updating the data, readers retry if the sequence number
+ * was odd or has changed during the copy. Data is stored in atomic words,
+ * so concurrent access to it is well defined. Raw setpoints are published
+ * along with the response for binary protocol replies.
+ * There must be a single writer at a time.
+ */
+class QueryCache
+{
+public:
+    QueryCache();
+
+    // serialize and publish new ship status
+    void publish(Setpoint speed, Setpoint steering);
+    // copy current response into out; returns false if nothing has been published yet
+    bool read(std::string &out) const;
+    // copy current setpoints; returns false if nothing has been published yet
+    bool read_setpoints(Setpoint &speed, Setpoint &steering) const;
+    // number of published snapshots
+    std::uint32_t get_version() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+protected:
+    static const std::size_t WORDS = QUERY_CACHE_SIZE / sizeof(std::uint64_t);
+
+    std::atomic<std::uint32_t> _seq;
+    std::atomic<std::uint32_t> _len;
+    // speed in the low half, steering in the high half
+    std::atomic<std::uint32_t> _setpoints;
+    std::atomic<std::uint64_t> _data[WORDS];
+};
+
+} // namespace shipcontrol
+
+#endif // QUERYCACHE_HPP
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RAMPCONFIG_HPP
+#define RAMPCONFIG_HPP
+
+namespace shipcontrol
+{
+
+// limits of a single ramped channel, 0 means no limit
+struct RampLimits
+{
+    // max rate of change in per-mille of full scale per second
+    unsigned int rate = 0;
+    // max acceleration in per-mille of full scale per second squared
+    unsigned int accel = 0;
+
+    bool is_limited() const { return (rate != 0) || (accel != 0); }
+};
+
+// slew rate limiting of actuator setpoints
+struct RampConfig
+{
+    // control loop ticks per second
+    unsigned int tick_rate = 50;
+    RampLimits speed;
+    RampLimits steering;
+
+    bool is_enabled() const { return speed.is_limited() || steering.is_limited(); }
+};
+
+} // namespace shipcontrol
+
+#endif // RAMPCONFIG_HPP
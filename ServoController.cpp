@@ -19,154 +19,193 @@
  */
 
 #include "ServoController.hpp"
-#include <stdexcept>
 
 namespace shipcontrol
 {
 
-std::unordered_map<SpeedVal, std::string> ServoController::_speed_map = {
-    {SpeedVal::STOP, "stop"},
-    {SpeedVal::FWD10, "fwd10"},
-    {SpeedVal::FWD20, "fwd20"},
-    {SpeedVal::FWD30, "fwd30"},
-    {SpeedVal::FWD40, "fwd40"},
-    {SpeedVal::FWD50, "fwd50"},
-    {SpeedVal::FWD60, "fwd60"},
-    {SpeedVal::FWD70, "fwd70"},
-    {SpeedVal::FWD80, "fwd80"},
-    {SpeedVal::FWD90, "fwd90"},
-    {SpeedVal::FWD100, "fwd100"},
-    {SpeedVal::REV10, "rev10"},
-    {SpeedVal::REV20, "rev20"},
-    {SpeedVal::REV30, "rev30"},
-    {SpeedVal::REV40, "rev40"},
-    {SpeedVal::REV50, "rev50"},
-    {SpeedVal::REV60, "rev60"},
-    {SpeedVal::REV70, "rev70"},
-    {SpeedVal::REV80, "rev80"},
-    {SpeedVal::REV90, "rev90"},
-    {SpeedVal::REV100, "rev100"}
+// names of values indexed by value + VALUE_OFFSET
+static constexpr int VALUE_OFFSET = 10;
+static constexpr int VALUE_COUNT = 2 * VALUE_OFFSET + 1;
+
+static constexpr const char *SPEED_NAMES[VALUE_COUNT] = {
+    "rev100", "rev90", "rev80", "rev70", "rev60", "rev50", "rev40", "rev30", "rev20", "rev10",
+    "stop",
+    "fwd10", "fwd20", "fwd30", "fwd40", "fwd50", "fwd60", "fwd70", "fwd80", "fwd90", "fwd100"
 };
 
-std::unordered_map<SteeringVal, std::string> ServoController::_steering_map = {
-    {SteeringVal::STRAIGHT, "straight"},
-    {SteeringVal::RIGHT10, "right10"},
-    {SteeringVal::RIGHT20, "right20"},
-    {SteeringVal::RIGHT30, "right30"},
-    {SteeringVal::RIGHT40, "right40"},
-    {SteeringVal::RIGHT50, "right50"},
-    {SteeringVal::RIGHT60, "right60"},
-    {SteeringVal::RIGHT70, "right70"},
-    {SteeringVal::RIGHT80, "right80"},
-    {SteeringVal::RIGHT90, "right90"},
-    {SteeringVal::RIGHT100, "right100"},
-    {SteeringVal::LEFT10, "left10"},
-    {SteeringVal::LEFT20, "left20"},
-    {SteeringVal::LEFT30, "left30"},
-    {SteeringVal::LEFT40, "left40"},
-    {SteeringVal::LEFT50, "left50"},
-    {SteeringVal::LEFT60, "left60"},
-    {SteeringVal::LEFT70, "left70"},
-    {SteeringVal::LEFT80, "left80"},
-    {SteeringVal::LEFT90, "left90"},
-    {SteeringVal::LEFT100, "left100"}
+static constexpr const char *STEERING_NAMES[VALUE_COUNT] = {
+    "left100", "left90", "left80", "left70", "left60", "left50", "left40", "left30", "left20", "left10",
+    "straight",
+    "right10", "right20", "right30", "right40", "right50", "right60", "right70", "right80", "right90", "right100"
 };
 
-std::unordered_set<std::string> ServoController::_speed_values = std::move(init_speed_values());
-std::unordered_set<std::string> ServoController::_steering_values = std::move(init_steering_values());
+// make sure the tables match enum values
+static_assert(static_cast<int>(SpeedVal::REV100) + VALUE_OFFSET == 0, "unexpected SpeedVal range");
+static_assert(static_cast<int>(SpeedVal::FWD100) + VALUE_OFFSET == VALUE_COUNT - 1, "unexpected SpeedVal range");
+static_assert(static_cast<int>(SteeringVal::LEFT100) + VALUE_OFFSET == 0, "unexpected SteeringVal range");
+static_assert(static_cast<int>(SteeringVal::RIGHT100) + VALUE_OFFSET == VALUE_COUNT - 1, "unexpected SteeringVal range");
 
-std::unordered_set<std::string> ServoController::init_speed_values()
+// parse percentage "10", "20", ... "100" into the number of steps; returns 0 if invalid
+static constexpr int parse_steps(std::string_view digits)
 {
-    std::unordered_set<std::string> speed_set;
-    for (const std::pair<SpeedVal, std::string> &item : _speed_map)
+    if (digits == "100")
+    {
+        return 10;
+    }
+    if ((digits.size() == 2) && (digits[0] >= '1') && (digits[0] <= '9') && (digits[1] == '0'))
     {
-        speed_set.insert(item.second);
+        return digits[0] - '0';
     }
-    return std::move(speed_set);
+    return 0;
 }
 
-std::unordered_set<std::string> ServoController::init_steering_values()
+// parse "<negative prefix><percentage>", "<positive prefix><percentage>" or zero value name
+// into the number of steps, returns false if the string is invalid
+static constexpr bool parse_value(std::string_view str, std::string_view neg_prefix,
+                                  std::string_view pos_prefix, std::string_view zero, int &steps)
 {
-    std::unordered_set<std::string> steering_set;
-    for (const std::pair<SteeringVal, std::string> &item : _steering_map)
+    if (str == zero)
     {
-        steering_set.insert(item.second);
+        steps = 0;
+        return true;
     }
-    return std::move(steering_set);
-}
 
-std::string ServoController::speed_to_str(SpeedVal speed)
-{
-    try
+    int sign = 0;
+    std::size_t prefix_len = 0;
+    if (str.substr(0, neg_prefix.size()) == neg_prefix)
     {
-        return _speed_map.at(speed);
+        sign = -1;
+        prefix_len = neg_prefix.size();
     }
-    catch (const std::out_of_range &e)
+    else if (str.substr(0, pos_prefix.size()) == pos_prefix)
+    {
+        sign = 1;
+        prefix_len = pos_prefix.size();
+    }
+    else
+    {
+        return false;
+    }
+
+    int value = parse_steps(str.substr(prefix_len));
+    if (value == 0)
     {
-        return std::string("");
+        return false;
     }
+    steps = sign * value;
+    return true;
+}
+
+static constexpr bool parse_speed_steps(std::string_view str, int &steps)
+{
+    return parse_value(str, "rev", "fwd", "stop", steps);
+}
+
+static constexpr bool parse_steering_steps(std::string_view str, int &steps)
+{
+    return parse_value(str, "left", "right", "straight", steps);
 }
 
-SpeedVal ServoController::str_to_speed(const std::string &str)
+const char *ServoController::speed_name(SpeedVal speed)
 {
-    for (const std::pair<SpeedVal, std::string> &item : _speed_map)
+    int index = static_cast<int>(speed) + VALUE_OFFSET;
+    if ((index < 0) || (index >= VALUE_COUNT))
     {
-        if (item.second == str)
-        {
-            return item.first;
-        }
+        return "";
     }
-
-    return SpeedVal::STOP;
+    return SPEED_NAMES[index];
 }
 
-std::string ServoController::steering_to_str(SteeringVal steering)
+const char *ServoController::steering_name(SteeringVal steering)
 {
-    try
+    int index = static_cast<int>(steering) + VALUE_OFFSET;
+    if ((index < 0) || (index >= VALUE_COUNT))
     {
-        return _steering_map.at(steering);
+        return "";
     }
-    catch (const std::out_of_range &e)
+    return STEERING_NAMES[index];
+}
+
+bool ServoController::parse_speed(std::string_view str, SpeedVal &speed)
+{
+    int steps = 0;
+    if (parse_speed_steps(str, steps) == false)
     {
-        return std::string("");
+        return false;
     }
+    speed = static_cast<SpeedVal>(steps);
+    return true;
 }
 
-SteeringVal ServoController::str_to_steering(const std::string &str)
+bool ServoController::parse_steering(std::string_view str, SteeringVal &steering)
 {
-    for (const std::pair<SteeringVal, std::string> &item : _steering_map)
+    int steps = 0;
+    if (parse_steering_steps(str, steps) == false)
     {
-        if (item.second == str)
-        {
-            return item.first;
-        }
+        return false;
     }
+    steering = static_cast<SteeringVal>(steps);
+    return true;
+}
 
-    return SteeringVal::STRAIGHT;
+SpeedVal ServoController::str_to_speed(std::string_view str)
+{
+    SpeedVal speed = SpeedVal::STOP;
+    parse_speed(str, speed);
+    return speed;
 }
 
-bool ServoController::validate_speed_str(const std::string &str)
+SteeringVal ServoController::str_to_steering(std::string_view str)
 {
-    if (_speed_values.find(str) != _speed_values.end())
+    SteeringVal steering = SteeringVal::STRAIGHT;
+    parse_steering(str, steering);
+    return steering;
+}
+
+bool ServoController::validate_speed_str(std::string_view str)
+{
+    int steps = 0;
+    return parse_speed_steps(str, steps);
+}
+
+bool ServoController::validate_steering_str(std::string_view str)
+{
+    int steps = 0;
+    return parse_steering_steps(str, steps);
+}
+
+Setpoint ServoController::clamp_setpoint(int value)
+{
+    if (value > SETPOINT_MAX)
     {
-        return true;
+        return SETPOINT_MAX;
     }
-    else
+    else if (value < -SETPOINT_MAX)
     {
-        return false;
+        return -SETPOINT_MAX;
     }
+    return static_cast<Setpoint>(value);
 }
 
-bool ServoController::validate_steering_str(const std::string &str)
+// round setpoint to the nearest step, halfway values are rounded away from zero
+static int setpoint_to_steps(Setpoint setpoint)
 {
-    if (_steering_values.find(str) != _steering_values.end())
-    {
-        return true;
-    }
-    else
+    int value = ServoController::clamp_setpoint(setpoint);
+    if (value >= 0)
     {
-        return false;
+        return (value + SETPOINT_STEP / 2) / SETPOINT_STEP;
     }
+    return -((-value + SETPOINT_STEP / 2) / SETPOINT_STEP);
+}
+
+SpeedVal ServoController::setpoint_to_speed(Setpoint speed)
+{
+    return static_cast<SpeedVal>(setpoint_to_steps(speed));
+}
+
+SteeringVal ServoController::setpoint_to_steering(Setpoint steering)
+{
+    return static_cast<SteeringVal>(setpoint_to_steps(steering));
 }
 
 } // namespace shipcontrol
@@ -21,9 +21,11 @@
 #ifndef SERVO_CONTROLLER_HPP
 #define SERVO_CONTROLLER_HPP
 
-#include <unordered_map>
-#include <unordered_set>
 #include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "RampConfig.hpp"
 
 namespace shipcontrol
 {
@@ -80,6 +82,14 @@ enum class SteeringVal
     LEFT100 = -10
 };
 
+// continuous speed or steering value in per-mille of maximum,
+// from -SETPOINT_MAX (full reverse, full left) to SETPOINT_MAX (full forward, full right)
+typedef std::int16_t Setpoint;
+
+#define SETPOINT_MAX    1000
+// setpoint distance between adjacent SpeedVal/SteeringVal values
+#define SETPOINT_STEP   100
+
 // servo controller interface
 class ServoController
 {
@@ -89,28 +99,47 @@ public:
     virtual void start() = 0;
     virtual void stop() = 0;
 
-    virtual SpeedVal get_speed() = 0;
-    virtual void set_speed(SpeedVal speed) = 0;
-    virtual SteeringVal get_steering() = 0;
-    virtual void set_steering(SteeringVal steering) = 0;
+    virtual Setpoint get_speed_setpoint() = 0;
+    virtual void set_speed_setpoint(Setpoint speed) = 0;
+    virtual Setpoint get_steering_setpoint() = 0;
+    virtual void set_steering_setpoint(Setpoint steering) = 0;
+
+    // false if the controller doesn't drive the axis, so that its setpoints are ignored
+    virtual bool drives_speed() { return true; }
+    virtual bool drives_steering() { return true; }
+
+    // configure ramping of setpoint changes in hardware; returns false if
+    // the controller can't do it, so that setpoints must be ramped by the caller
+    virtual bool set_ramp(const RampConfig &/*config*/) { return false; }
+
+    // compatibility API, setpoints are rounded to the nearest 10% step
+    SpeedVal get_speed() { return setpoint_to_speed(get_speed_setpoint()); }
+    void set_speed(SpeedVal speed) { set_speed_setpoint(speed_to_setpoint(speed)); }
+    SteeringVal get_steering() { return setpoint_to_steering(get_steering_setpoint()); }
+    void set_steering(SteeringVal steering) { set_steering_setpoint(steering_to_setpoint(steering)); }
 
-    static std::string speed_to_str(SpeedVal speed);
-    static SpeedVal str_to_speed(const std::string &str);
+    static Setpoint clamp_setpoint(int value);
+    static Setpoint speed_to_setpoint(SpeedVal speed) { return static_cast<Setpoint>(speed) * SETPOINT_STEP; }
+    static SpeedVal setpoint_to_speed(Setpoint speed);
+    static Setpoint steering_to_setpoint(SteeringVal steering) { return static_cast<Setpoint>(steering) * SETPOINT_STEP; }
+    static SteeringVal setpoint_to_steering(Setpoint steering);
 
-    static std::string steering_to_str(SteeringVal steering);
-    static SteeringVal str_to_steering(const std::string &str);
+    // string names of values; empty string is returned for invalid values
+    static const char *speed_name(SpeedVal speed);
+    static const char *steering_name(SteeringVal steering);
+    static std::string speed_to_str(SpeedVal speed) { return speed_name(speed); }
+    static std::string steering_to_str(SteeringVal steering) { return steering_name(steering); }
 
-    static bool validate_speed_str(const std::string &str);
-    static bool validate_steering_str(const std::string &str);
+    // return false if the string isn't a valid value name
+    static bool parse_speed(std::string_view str, SpeedVal &speed);
+    static bool parse_steering(std::string_view str, SteeringVal &steering);
 
-private:
-    static std::unordered_map<SpeedVal, std::string> _speed_map;
-    static std::unordered_map<SteeringVal, std::string> _steering_map;
-    static std::unordered_set<std::string> _speed_values;
-    static std::unordered_set<std::string> _steering_values;
+    // invalid strings are converted to STOP and STRAIGHT
+    static SpeedVal str_to_speed(std::string_view str);
+    static SteeringVal str_to_steering(std::string_view str);
 
-    static std::unordered_set<std::string> init_speed_values();
-    static std::unordered_set<std::string> init_steering_values();
+    static bool validate_speed_str(std::string_view str);
+    static bool validate_steering_str(std::string_view str);
 };
 
 } // namespace shipcontrol
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ServoRamp.hpp"
+#include <cmath>
+
+namespace shipcontrol
+{
+
+ServoRamp::ServoRamp(const RampLimits &limits, unsigned int tick_rate) :
+    _limited(limits.is_limited()),
+    _max_step(0.0),
+    _accel_step(0.0),
+    _target(0),
+    _output(0),
+    _position(0.0),
+    _velocity(0.0)
+{
+    if (tick_rate == 0)
+    {
+        tick_rate = 1;
+    }
+    _max_step = static_cast<double>(limits.rate) / tick_rate;
+    _accel_step = static_cast<double>(limits.accel) / tick_rate / tick_rate;
+}
+
+void ServoRamp::reset(Setpoint value)
+{
+    _target = value;
+    _output = value;
+    _position = value;
+    _velocity = 0.0;
+}
+
+bool ServoRamp::tick()
+{
+    Setpoint prev = _output;
+
+    double distance = _target - _position;
+    if ((_limited == false) || (distance == 0.0))
+    {
+        reset(_target);
+        return (_output != prev);
+    }
+
+    double dir = (distance > 0.0) ? 1.0 : -1.0;
+    distance = std::fabs(distance);
+    // velocity along the direction toward the target, negative if moving away
+    double velocity = _velocity * dir;
+
+    if (_accel_step > 0.0)
+    {
+        // fastest velocity, which still allows to stop at the target
+        double stop_velocity = std::sqrt(2.0 * _accel_step * distance);
+        velocity += _accel_step;
+        if (velocity > stop_velocity)
+        {
+            velocity = stop_velocity;
+        }
+    }
+    else
+    {
+        velocity = _max_step;
+    }
+    if ((_max_step > 0.0) && (velocity > _max_step))
+    {
+        velocity = _max_step;
+    }
+
+    if (velocity >= distance)
+    {
+        reset(_target);
+    }
+    else
+    {
+        _position += velocity * dir;
+        _velocity = velocity * dir;
+        _output = static_cast<Setpoint>(std::lround(_position));
+    }
+
+    return (_output != prev);
+}
+
+} // namespace shipcontrol
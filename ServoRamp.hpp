@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SERVORAMP_HPP
+#define SERVORAMP_HPP
+
+#include "ServoController.hpp"
+#include "RampConfig.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Slew rate and acceleration limiter of a single setpoint channel.
+ * Output moves toward the target by at most one step per tick; with an
+ * acceleration limit the movement speeds up and slows down gradually, so that
+ * output stops at the target without overshooting.
+ */
+class ServoRamp
+{
+public:
+    ServoRamp(const RampLimits &limits, unsigned int tick_rate);
+
+    bool is_limited() const { return _limited; }
+    void set_target(Setpoint target) { _target = target; }
+    Setpoint get_target() const { return _target; }
+    Setpoint get_output() const { return _output; }
+    bool is_settled() const { return (_output == _target) && (_velocity == 0.0); }
+    // move output to the given value immediately
+    void reset(Setpoint value);
+
+    // advance by one tick, returns true if the output has changed
+    bool tick();
+
+protected:
+    bool _limited;
+    // limits in per-mille per tick and per tick squared
+    double _max_step;
+    double _accel_step;
+    Setpoint _target;
+    Setpoint _output;
+    double _position;
+    double _velocity;
+};
+
+} // namespace shipcontrol
+
+#endif // SERVORAMP_HPP
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "SimulatedController.hpp"
+
+namespace shipcontrol
+{
+
+SimulatedController::SimulatedController(const std::string &name, unsigned int delay,
+                                         bool speed, bool steering) :
+    _speed(0),
+    _steering(0),
+    _updates(0),
+    _delay(delay),
+    _drives_speed(speed),
+    _drives_steering(steering)
+{
+    _updates_metric = Metrics::counter("shipcontrol_sim_updates_total",
+                                       "Updates of simulated controllers",
+                                       "controller=\"" + name + "\"");
+}
+
+void SimulatedController::set_speed_setpoint(Setpoint speed)
+{
+    simulate_io();
+    _speed.store(clamp_setpoint(speed), std::memory_order_relaxed);
+}
+
+void SimulatedController::set_steering_setpoint(Setpoint steering)
+{
+    simulate_io();
+    _steering.store(clamp_setpoint(steering), std::memory_order_relaxed);
+}
+
+void SimulatedController::simulate_io()
+{
+    if (_delay != 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(_delay));
+    }
+    _updates.fetch_add(1, std::memory_order_relaxed);
+    _updates_metric->inc();
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SIMULATEDCONTROLLER_HPP
+#define SIMULATEDCONTROLLER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "ServoController.hpp"
+#include "Metrics.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Controller without hardware, used for load and soak testing.
+ * Keeps the latest setpoints and counts updates. Every update may take
+ * a configured time to simulate slow I/O of a real controller.
+ */
+class SimulatedController : public ServoController
+{
+public:
+    // delay in microseconds; a controller standing in for a real one drives only its axes
+    SimulatedController(const std::string &name, unsigned int delay = 0,
+                        bool speed = true, bool steering = true);
+    SimulatedController(const SimulatedController &other) = delete;
+    virtual ~SimulatedController() {}
+
+    // ServoController implementation
+    virtual Setpoint get_speed_setpoint() { return _speed.load(std::memory_order_relaxed); }
+    virtual void set_speed_setpoint(Setpoint speed);
+    virtual Setpoint get_steering_setpoint() { return _steering.load(std::memory_order_relaxed); }
+    virtual void set_steering_setpoint(Setpoint steering);
+    virtual bool drives_speed() { return _drives_speed; }
+    virtual bool drives_steering() { return _drives_steering; }
+
+    virtual void start() {}
+    virtual void stop() {}
+
+    // number of speed and steering updates
+    std::uint64_t get_updates() { return _updates.load(std::memory_order_relaxed); }
+
+protected:
+    void simulate_io();
+
+    std::atomic<Setpoint> _speed;
+    std::atomic<Setpoint> _steering;
+    std::atomic<std::uint64_t> _updates;
+    unsigned int _delay;
+    bool _drives_speed;
+    bool _drives_steering;
+    Metric *_updates_metric;
+};
+
+} // namespace shipcontrol
+
+#endif // SIMULATEDCONTROLLER_HPP
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SIMULATIONCONFIG_HPP
+#define SIMULATIONCONFIG_HPP
+
+#include <string>
+
+namespace shipcontrol
+{
+
+// hardware-free simulation backends, all disabled by default
+struct SimulationConfig
+{
+    // replace GPIO controllers which need a GPIO chip (S/W PWM or direction line)
+    // with simulated ones and disable water cooling switch
+    bool gpio = false;
+    // number of additional simulated controllers
+    unsigned int controllers = 0;
+    // duration of every update of a simulated controller in microseconds
+    unsigned int controller_delay = 0;
+    // connect Maestro controller to a simulated Maestro instead of maestro_device
+    bool maestro = false;
+    // root directory of fake sysfs PWM tree, H/W PWM lines are redirected to it if set
+    std::string sysfs_pwm;
+
+    bool is_enabled() const { return gpio || (controllers != 0) || maestro || !sysfs_pwm.empty(); }
+};
+
+} // namespace shipcontrol
+
+#endif // SIMULATIONCONFIG_HPP
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SysfsPWMSimulator.hpp"
+
+namespace shipcontrol
+{
+
+SysfsPWMSimulator::SysfsPWMSimulator(const std::string &root) :
+    _root(root)
+{
+    _log = Log::getInstance();
+    make_dir(_root);
+}
+
+SysfsPWMSimulator::~SysfsPWMSimulator()
+{
+    for (auto it = _created.rbegin(); it != _created.rend(); ++it)
+    {
+        if (unlink(it->c_str()) == -1)
+        {
+            rmdir(it->c_str());
+        }
+    }
+    Log::release();
+}
+
+std::string SysfsPWMSimulator::add_pwm(const std::string &chip_path, unsigned int num)
+{
+    // chips are distinguished by the last path component, e.g. pwmchip0
+    std::string::size_type pos = chip_path.find_last_of('/');
+    std::string chip = (pos == std::string::npos) ? chip_path : chip_path.substr(pos + 1);
+    std::string fake_chip_path = _root + "/" + chip;
+    std::string line_path = fake_chip_path + "/pwm" + std::to_string(num);
+
+    if ((make_dir(fake_chip_path) == false) ||
+        (make_file(fake_chip_path + "/export") == false) ||
+        (make_dir(line_path) == false) ||
+        (make_file(line_path + "/period") == false) ||
+        (make_file(line_path + "/duty_cycle") == false) ||
+        (make_file(line_path + "/enable") == false))
+    {
+        _log->write(LogLevel::ERROR, "SysfsPWMSimulator failed to create %s, error code %d\n",
+                    line_path.c_str(), errno);
+        return chip_path;
+    }
+
+    return fake_chip_path;
+}
+
+bool SysfsPWMSimulator::make_dir(const std::string &path)
+{
+    if (mkdir(path.c_str(), 0755) == 0)
+    {
+        _created.push_back(path);
+        return true;
+    }
+    // shared by several lines or left by a previous run
+    return errno == EEXIST;
+}
+
+bool SysfsPWMSimulator::make_file(const std::string &path)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        return errno == EEXIST;
+    }
+    close(fd);
+    _created.push_back(path);
+    return true;
+}
+
+} // namespace shipcontrol
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SYSFSPWMSIMULATOR_HPP
+#define SYSFSPWMSIMULATOR_HPP
+
+#include <string>
+#include <vector>
+
+#include "Log.hpp"
+
+namespace shipcontrol
+{
+
+/*
+ * Fake sysfs PWM tree for running H/W PWM lines without hardware.
+ * For every PWM line a chip directory with "export" file and pwmN directory
+ * with "period", "duty_cycle" and "enable" files is created under the root
+ * directory (normally in tmpfs). GPIOSysfsPWM writes to these files exactly
+ * as it does to sysfs. The files aren't truncated on writes, so a shorter
+ * value leaves bytes of a longer one after its newline; readers must take the
+ * first line only. Created files are removed on destruction.
+ */
+class SysfsPWMSimulator
+{
+public:
+    SysfsPWMSimulator(const std::string &root);
+    SysfsPWMSimulator(const SysfsPWMSimulator &other) = delete;
+    virtual ~SysfsPWMSimulator();
+
+    // creates fake PWM line for sysfs chip path (e.g. /sys/class/pwm/pwmchip0),
+    // returns fake chip path to be used instead, or chip_path itself if the files can't be created
+    std::string add_pwm(const std::string &chip_path, unsigned int num);
+
+protected:
+    bool make_dir(const std::string &path);
+    bool make_file(const std::string &path);
+
+    std::string _root;
+    // created directories and files, removed in reverse order
+    std::vector<std::string> _created;
+    Log *_log;
+};
+
+} // namespace shipcontrol
+
+#endif // SYSFSPWMSIMULATOR_HPP
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2018 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,36 +19,55 @@
  */
 
 #include "UnixListener.hpp"
+#include "Metrics.hpp"
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <cstring>
+#include <cstdint>
 
 namespace shipcontrol
 {
 
+static Metric *ipc_clients = Metrics::gauge("shipcontrol_ipc_clients", "Connected IPC clients");
+static Metric *ipc_connections = Metrics::counter("shipcontrol_ipc_connections_total", "Accepted IPC connections");
+
 UnixListener::UnixListener(IPCConfig &config, IPCRequestHandler &handler)
 : _config(config),
   _fd(-1),
-  _rq_handler(handler)
+  _epoll_fd(-1),
+  _rq_handler(handler),
+  _client_count(0)
 {
     _log = Log::getInstance();
     _socket_name = _config.get_unix_socket_name();
+    // created here rather than in setup(), so that stop() can't miss it
+    _stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stop_fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "UnixListener failed to create eventfd, error code %d\n", errno);
+    }
 }
 
 UnixListener::~UnixListener()
 {
-    Log::release();
-    for (IPCClient *cl : _cl_handlers)
+    if (_stop_fd != -1)
+    {
+        close(_stop_fd);
+    }
+    for (IPCBuffers *buffers : _buffer_pool)
     {
-        delete cl;
+        delete buffers;
     }
+    Log::release();
 }
 
 void UnixListener::run()
 {
-    _log->write(LogLevel::DEBUG, "UnixListener::run()\n");
+    LOG_DEBUG(_log, "UnixListener::run()\n");
 
     if (setup() != true)
     {
@@ -56,38 +75,67 @@ void UnixListener::run()
         return;
     }
 
-    while (true)
+    epoll_event events[IPC_EPOLL_EVENTS];
+    bool stop = false;
+
+    while (stop == false)
     {
-        if (need_to_stop() == true)
+        int count = epoll_wait(_epoll_fd, events, IPC_EPOLL_EVENTS, -1);
+        if (count == -1)
         {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            _log->write(LogLevel::ERROR, "UnixListener epoll_wait failed, error code %d\n", errno);
             break;
         }
 
-        int clientsock = accept(_fd, nullptr, nullptr);
-        if (clientsock == -1)
+        for (int i = 0; i < count; i++)
         {
-            _log->write(LogLevel::NOTICE, "UnixListener failed to accept connection, error code %d", errno);
-            continue;
+            int fd = events[i].data.fd;
+            if (fd == _stop_fd)
+            {
+                stop = true;
+            }
+            else if (fd == _fd)
+            {
+                accept_clients();
+            }
+            else
+            {
+                handle_client_event(fd, events[i].events);
+            }
         }
-
-        // handle data exchange in a separate client thread, here we just listen for new connections
-        IPCClient *client = new IPCClient(clientsock, _rq_handler);
-        _cl_handlers.push_back(client);
-        client->start();
     }
+
+    teardown();
 }
 
 void UnixListener::stop()
 {
-    teardown();
+    if (_stop_fd != -1)
+    {
+        // wake up the event loop, it will tear everything down on its own
+        std::uint64_t val = 1;
+        if (write(_stop_fd, &val, sizeof(val)) == -1)
+        {
+            _log->write(LogLevel::ERROR, "UnixListener failed to signal stop, error code %d\n", errno);
+        }
+    }
     SingleThread::stop();
 }
 
 bool UnixListener::setup()
 {
-    _log->write(LogLevel::DEBUG, "UnixListener::setup()\n");
+    LOG_DEBUG(_log, "UnixListener::setup()\n");
+
+    if (_stop_fd == -1)
+    {
+        return false;
+    }
 
-    _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    _fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (_fd == -1)
     {
         _log->write(LogLevel::ERROR, "UnixListener failed to open socket, error code %d\n", errno);
@@ -98,7 +146,7 @@ bool UnixListener::setup()
     addr.sun_family = AF_UNIX;
     std::strncpy(addr.sun_path, _socket_name.c_str(), sizeof(addr.sun_path) - 1);
 
-    _log->write(LogLevel::DEBUG, "UnixListener opening Unix socket %s\n", addr.sun_path);
+    LOG_DEBUG(_log, "UnixListener opening Unix socket %s\n", addr.sun_path);
 
     if (bind(_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(sockaddr_un)) == -1)
     {
@@ -106,22 +154,55 @@ bool UnixListener::setup()
         return false;
     }
 
-    if (listen(_fd, 32) == -1)
+    if (listen(_fd, SOMAXCONN) == -1)
     {
         _log->write(LogLevel::ERROR, "UnixListener failed to listen socket, error code %d\n", errno);
         return false;
     }
 
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd == -1)
+    {
+        _log->write(LogLevel::ERROR, "UnixListener failed to create epoll instance, error code %d\n", errno);
+        return false;
+    }
+
+    epoll_event evt;
+    std::memset(&evt, 0, sizeof(evt));
+    evt.events = EPOLLIN;
+    evt.data.fd = _stop_fd;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _stop_fd, &evt) == -1)
+    {
+        _log->write(LogLevel::ERROR, "UnixListener failed to add eventfd to epoll, error code %d\n", errno);
+        return false;
+    }
+    evt.data.fd = _fd;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _fd, &evt) == -1)
+    {
+        _log->write(LogLevel::ERROR, "UnixListener failed to add socket to epoll, error code %d\n", errno);
+        return false;
+    }
+
     return true;
 }
 
 void UnixListener::teardown()
 {
-    _log->write(LogLevel::DEBUG, "UnixListener::stop()\n");
+    LOG_DEBUG(_log, "UnixListener::teardown()\n");
+
+    for (auto &item : _clients)
+    {
+        put_buffers(item.second->release_buffers());
+        delete item.second;
+    }
+    _clients.clear();
+    _client_count = 0;
+    ipc_clients->set(0);
 
-    for (IPCClient *cl : _cl_handlers)
+    if (_epoll_fd != -1)
     {
-        cl->stop();
+        close(_epoll_fd);
+        _epoll_fd = -1;
     }
 
     if (_fd != -1)
@@ -132,4 +213,127 @@ void UnixListener::teardown()
     }
 }
 
+void UnixListener::accept_clients()
+{
+    while (true)
+    {
+        int clientsock = accept4(_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientsock == -1)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+            {
+                _log->write(LogLevel::NOTICE, "UnixListener failed to accept connection, error code %d\n", errno);
+            }
+            return;
+        }
+
+        epoll_event evt;
+        std::memset(&evt, 0, sizeof(evt));
+        evt.events = EPOLLIN;
+        evt.data.fd = clientsock;
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, clientsock, &evt) == -1)
+        {
+            _log->write(LogLevel::NOTICE, "UnixListener failed to add client to epoll, error code %d\n", errno);
+            close(clientsock);
+            continue;
+        }
+
+        IPCClient *client = new IPCClient(clientsock, _rq_handler, get_buffers());
+        client->set_epoll_events(EPOLLIN);
+        _clients[clientsock] = client;
+        _client_count = _clients.size();
+        ipc_clients->set(_clients.size());
+        ipc_connections->inc();
+    }
+}
+
+void UnixListener::handle_client_event(int fd, unsigned int events)
+{
+    auto match = _clients.find(fd);
+    if (match == _clients.end())
+    {
+        return;
+    }
+    IPCClient *client = match->second;
+
+    bool ok = true;
+    if (events & EPOLLOUT)
+    {
+        ok = client->on_writable();
+    }
+    if (ok && (events & EPOLLIN))
+    {
+        ok = client->on_readable();
+    }
+    if (ok && (events & (EPOLLERR | EPOLLHUP)) && !(events & EPOLLIN))
+    {
+        ok = false;
+    }
+
+    if (ok)
+    {
+        update_client_events(client);
+    }
+    else
+    {
+        close_client(client);
+    }
+}
+
+void UnixListener::update_client_events(IPCClient *client)
+{
+    // stop reading requests while the client doesn't consume responses
+    unsigned int events = client->has_pending_output() ? EPOLLOUT : EPOLLIN;
+    if (events == client->get_epoll_events())
+    {
+        return;
+    }
+
+    epoll_event evt;
+    std::memset(&evt, 0, sizeof(evt));
+    evt.events = events;
+    evt.data.fd = client->get_fd();
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, client->get_fd(), &evt) == 0)
+    {
+        client->set_epoll_events(events);
+    }
+}
+
+void UnixListener::close_client(IPCClient *client)
+{
+    // closing the descriptor removes it from the epoll set as well
+    _clients.erase(client->get_fd());
+    _client_count = _clients.size();
+    ipc_clients->set(_clients.size());
+    put_buffers(client->release_buffers());
+    delete client;
+}
+
+IPCBuffers *UnixListener::get_buffers()
+{
+    if (_buffer_pool.empty())
+    {
+        return new IPCBuffers();
+    }
+    IPCBuffers *buffers = _buffer_pool.back();
+    _buffer_pool.pop_back();
+    return buffers;
+}
+
+void UnixListener::put_buffers(IPCBuffers *buffers)
+{
+    if (buffers == nullptr)
+    {
+        return;
+    }
+    if (_buffer_pool.size() < IPC_BUFFER_POOL_SIZE)
+    {
+        _buffer_pool.push_back(buffers);
+    }
+    else
+    {
+        delete buffers;
+    }
+}
+
 } // namespace shipcontrol
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2018 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -26,11 +26,24 @@
 #include "SingleThread.hpp"
 #include "IPCRequestHandler.hpp"
 #include "IPCClient.hpp"
+#include <atomic>
+#include <unordered_map>
 #include <vector>
 
 namespace shipcontrol
 {
 
+// max number of events handled per epoll_wait() call
+#define IPC_EPOLL_EVENTS        64
+// max number of idle per-connection buffers kept for reuse
+#define IPC_BUFFER_POOL_SIZE    64
+
+/*
+ * Unix socket server.
+ * All client connections are multiplexed by a single epoll-based event loop
+ * running in the listener thread, so the number of threads doesn't depend
+ * on the number of connected clients.
+ */
 class UnixListener : public SingleThread
 {
 public:
@@ -39,16 +52,30 @@ public:
 
     virtual void run();
     virtual void stop();
+
+    // number of currently connected clients
+    std::size_t get_client_count() { return _client_count; }
 protected:
     bool setup();
     void teardown();
+    void accept_clients();
+    void handle_client_event(int fd, unsigned int events);
+    void close_client(IPCClient *client);
+    void update_client_events(IPCClient *client);
+    IPCBuffers *get_buffers();
+    void put_buffers(IPCBuffers *buffers);
 
     Log *_log;
     IPCConfig& _config;
     std::string _socket_name;
     int _fd;
+    int _epoll_fd;
+    // eventfd used to wake up the event loop on stop()
+    int _stop_fd;
     IPCRequestHandler &_rq_handler;
-    std::vector<IPCClient *> _cl_handlers;
+    std::unordered_map<int, IPCClient *> _clients;
+    std::atomic<std::size_t> _client_count;
+    std::vector<IPCBuffers *> _buffer_pool;
 };
 
 } // namespace shipcontrol
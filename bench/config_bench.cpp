@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "Config.hpp"
+
+#ifndef BENCHCONFIG_FILE
+#error "BENCHCONFIG_FILE is not defined"
+#endif
+
+namespace sc = shipcontrol;
+
+namespace config_bench
+{
+
+// reading and parsing of the full configuration file
+void BM_ConfigParse(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        sc::Config config(BENCHCONFIG_FILE);
+        benchmark::DoNotOptimize(config.is_ok());
+    }
+}
+BENCHMARK(BM_ConfigParse);
+
+} // namespace config_bench
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "GPIOUtil.hpp"
+
+namespace sc = shipcontrol;
+
+namespace gpio_util_bench
+{
+
+// fake sysfs PWM chip in tmpfs
+class FakePWMChip
+{
+public:
+    FakePWMChip()
+    {
+        char tmpl[] = "/dev/shm/scbenchXXXXXX";
+        if (mkdtemp(tmpl) == nullptr)
+        {
+            return;
+        }
+        _path = tmpl;
+        mkdir((_path + "/pwm0").c_str(), 0700);
+        const char *files[] = { "/export", "/pwm0/period", "/pwm0/duty_cycle", "/pwm0/enable" };
+        for (const char *file : files)
+        {
+            close(open((_path + file).c_str(), O_WRONLY | O_CREAT, 0600));
+        }
+    }
+
+    ~FakePWMChip()
+    {
+        if (_path.empty() == false)
+        {
+            const char *files[] = { "/export", "/pwm0/period", "/pwm0/duty_cycle", "/pwm0/enable" };
+            for (const char *file : files)
+            {
+                unlink((_path + file).c_str());
+            }
+            rmdir((_path + "/pwm0").c_str());
+            rmdir(_path.c_str());
+        }
+    }
+
+    std::string _path;
+};
+
+// one-shot write: open, write, close
+void BM_SysfsWrite(benchmark::State &state)
+{
+    FakePWMChip chip;
+    if (chip._path.empty())
+    {
+        state.SkipWithError("failed to create tmpfs directory");
+        return;
+    }
+    sc::Log *log = sc::Log::getInstance();
+    std::string path = chip._path + "/pwm0/duty_cycle";
+
+    unsigned long long value = 1000000;
+    for (auto _ : state)
+    {
+        sc::GPIOUtil::sysfs_write(path, std::to_string(value), log);
+        value = (value < 2000000) ? value + 1000 : 1000000;
+    }
+    sc::Log::release();
+}
+BENCHMARK(BM_SysfsWrite);
+
+// duty cycle update through persistent descriptors
+void BM_SysfsPWMDutyCycle(benchmark::State &state)
+{
+    FakePWMChip chip;
+    if (chip._path.empty())
+    {
+        state.SkipWithError("failed to create tmpfs directory");
+        return;
+    }
+    sc::GPIOSysfsPWM pwm(chip._path, 0);
+    pwm.enable(20000000, 1500000);
+
+    unsigned long long value = 1000000;
+    for (auto _ : state)
+    {
+        pwm.set_duty_cycle(value);
+        value = (value < 2000000) ? value + 1000 : 1000000;
+    }
+}
+BENCHMARK(BM_SysfsPWMDutyCycle);
+
+} // namespace gpio_util_bench
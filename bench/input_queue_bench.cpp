@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "InputQueue.hpp"
+
+namespace sc = shipcontrol;
+
+namespace input_queue_bench
+{
+
+// push and pop by the same thread, no contention
+void BM_PushPop(benchmark::State &state)
+{
+    sc::InputQueue queue;
+    sc::InputEvent evt{sc::InputEventType::SPEED_UP};
+
+    for (auto _ : state)
+    {
+        queue.push(evt);
+        queue.try_pop(evt);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PushPop);
+
+// the benchmark thread is the only consumer, given number of producers push continuously;
+// measures throughput of the main loop's side of the queue
+void BM_Producers(benchmark::State &state)
+{
+    sc::InputQueue queue;
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i < state.range(0); i++)
+    {
+        producers.emplace_back([&queue, &stop]() {
+            sc::InputEvent evt{sc::InputEventType::TURN_LEFT};
+            while (stop.load(std::memory_order_relaxed) == false)
+            {
+                if (queue.push(evt) == false)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    sc::InputEvent evt;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(evt = queue.pop_blocking());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = static_cast<double>(queue.get_dropped());
+
+    stop = true;
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+}
+BENCHMARK(BM_Producers)->ArgName("producers")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+} // namespace input_queue_bench
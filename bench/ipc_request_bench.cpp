@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "IPCRequestHandler.hpp"
+#include "json.hpp"
+
+namespace sc = shipcontrol;
+using json = nlohmann::json;
+
+namespace ipc_request_bench
+{
+
+class BenchDataProvider : public sc::DataProvider
+{
+public:
+    virtual sc::Setpoint get_speed_setpoint() { return 300; }
+    virtual sc::Setpoint get_steering_setpoint() { return -200; }
+};
+
+// gives access to the full JSON parser path
+class BenchRequestHandler : public sc::IPCRequestHandler
+{
+public:
+    using sc::IPCRequestHandler::IPCRequestHandler;
+    std::string handle_json(const std::string &request) { return handle_request_json(request, 0); }
+};
+
+const std::string CMD_RQ = "{\"type\":\"cmd\",\"cmd\":\"set_speed\",\"data\":\"fwd50\"}";
+const std::string QUERY_RQ = "{\"type\":\"query\"}";
+
+void BM_ParseFast(benchmark::State &state)
+{
+    sc::IPCRequest rq;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::IPCRequestParser::parse(CMD_RQ, rq));
+    }
+}
+BENCHMARK(BM_ParseFast);
+
+void BM_ParseDom(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        json j = json::parse(CMD_RQ);
+        benchmark::DoNotOptimize(j["type"].get<std::string>());
+        benchmark::DoNotOptimize(j["cmd"].get<std::string>());
+        benchmark::DoNotOptimize(j["data"].get<std::string>());
+    }
+}
+BENCHMARK(BM_ParseDom);
+
+// whole request handling; the queue is drained so that commands are never dropped
+void BM_Command(benchmark::State &state)
+{
+    sc::InputQueue queue;
+    BenchDataProvider provider;
+    BenchRequestHandler handler(queue, provider);
+    sc::InputEvent evt;
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(handler.handleRequest(CMD_RQ));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(handler.handle_json(CMD_RQ));
+        }
+        queue.try_pop(evt);
+    }
+}
+BENCHMARK(BM_Command)->ArgName("json")->Arg(0)->Arg(1);
+
+void BM_Query(benchmark::State &state)
+{
+    sc::InputQueue queue;
+    BenchDataProvider provider;
+    sc::QueryCache cache;
+    cache.publish(provider.get_speed_setpoint(), provider.get_steering_setpoint());
+    BenchRequestHandler handler(queue, provider, &cache);
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(handler.handleRequest(QUERY_RQ));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(handler.handle_json(QUERY_RQ));
+        }
+    }
+}
+BENCHMARK(BM_Query)->ArgName("json")->Arg(0)->Arg(1);
+
+} // namespace ipc_request_bench
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "MaestroController.hpp"
+
+namespace sc = shipcontrol;
+
+namespace maestro_bench
+{
+
+class BenchMaestroConfig : public sc::MaestroConfig
+{
+public:
+    BenchMaestroConfig(const std::string &dev, bool multi_target) : _dev(dev), _multi_target(multi_target) {}
+
+    virtual const char *get_maestro_dev() { return _dev.c_str(); }
+    virtual std::vector<sc::MaestroEngine> get_engine_channels()
+    {
+        return { sc::MaestroEngine{0, 1, true, 1500, 80},
+                 sc::MaestroEngine{2, sc::MaestroEngine::NO_CHANNEL, false, 1500, 80} };
+    }
+    virtual std::vector<int> get_steering_channels() { return { 4, 5 }; }
+    virtual sc::SteeringCalibration get_steering_calibration() { return sc::SteeringCalibration{1500, 80}; }
+    virtual int get_direction_high() { return sc::MaestroConfig::DEFAULT_DIR_HIGH; }
+    virtual int get_direction_low() { return sc::MaestroConfig::DEFAULT_DIR_LOW; }
+    virtual bool get_multi_target() { return _multi_target; }
+
+    std::string _dev;
+    bool _multi_target;
+};
+
+// pseudo terminal standing in for Maestro's serial device,
+// everything written by the controller is drained by a separate thread
+class FakeMaestro
+{
+public:
+    FakeMaestro() : _stop(false)
+    {
+        _master = posix_openpt(O_RDWR | O_NOCTTY);
+        if ((_master != -1) && (grantpt(_master) == 0) && (unlockpt(_master) == 0))
+        {
+            _slave_name = ptsname(_master);
+        }
+        _drain = std::thread([this]() {
+            unsigned char buf[4096];
+            pollfd pfd{_master, POLLIN, 0};
+            while (_stop.load() == false)
+            {
+                if ((poll(&pfd, 1, 10) > 0) && (read(_master, buf, sizeof(buf)) <= 0))
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    ~FakeMaestro()
+    {
+        _stop = true;
+        _drain.join();
+        if (_master != -1)
+        {
+            close(_master);
+        }
+    }
+
+    const std::string &get_dev() { return _slave_name; }
+
+protected:
+    int _master;
+    std::string _slave_name;
+    std::atomic<bool> _stop;
+    std::thread _drain;
+};
+
+// encoding and writing of a speed and a steering update
+void BM_MaestroUpdate(benchmark::State &state)
+{
+    FakeMaestro maestro;
+    if (maestro.get_dev().empty())
+    {
+        state.SkipWithError("failed to open pseudo terminal");
+        return;
+    }
+    BenchMaestroConfig config(maestro.get_dev(), state.range(0) != 0);
+    sc::MaestroController controller(config);
+
+    int setpoint = -SETPOINT_MAX;
+    for (auto _ : state)
+    {
+        controller.set_speed_setpoint(static_cast<sc::Setpoint>(setpoint));
+        controller.set_steering_setpoint(static_cast<sc::Setpoint>(-setpoint));
+        setpoint = (setpoint < SETPOINT_MAX) ? setpoint + 50 : -SETPOINT_MAX;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MaestroUpdate)->ArgName("multi_target")->Arg(0)->Arg(1);
+
+} // namespace maestro_bench
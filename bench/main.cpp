@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+    // results are reported as JSON unless another format is requested,
+    // so that runs can be stored and compared by tools/compare.py of Google Benchmark
+    std::vector<char *> args(argv, argv + argc);
+    bool format_set = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--benchmark_format", 18) == 0)
+        {
+            format_set = true;
+        }
+    }
+    char json_format[] = "--benchmark_format=json";
+    if (format_set == false)
+    {
+        args.push_back(json_format);
+    }
+    args.push_back(nullptr);
+    argc = static_cast<int>(args.size()) - 1;
+    argv = args.data();
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
+
+void signal_handler(int sig) {}
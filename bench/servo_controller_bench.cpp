@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "ServoController.hpp"
+
+namespace sc = shipcontrol;
+
+namespace servo_controller_bench
+{
+
+const char *SPEED_STRS[] = { "stop", "fwd50", "fwd100", "rev30", "rev100" };
+const std::size_t SPEED_STR_COUNT = sizeof(SPEED_STRS) / sizeof(SPEED_STRS[0]);
+
+void BM_ParseSpeed(benchmark::State &state)
+{
+    std::size_t i = 0;
+    sc::SpeedVal speed;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::parse_speed(SPEED_STRS[i], speed));
+        i = (i + 1) % SPEED_STR_COUNT;
+    }
+}
+BENCHMARK(BM_ParseSpeed);
+
+void BM_StrToSpeed(benchmark::State &state)
+{
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::str_to_speed(SPEED_STRS[i]));
+        i = (i + 1) % SPEED_STR_COUNT;
+    }
+}
+BENCHMARK(BM_StrToSpeed);
+
+void BM_SpeedName(benchmark::State &state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::speed_name(static_cast<sc::SpeedVal>(i - 10)));
+        i = (i + 1) % 21;
+    }
+}
+BENCHMARK(BM_SpeedName);
+
+void BM_SpeedToStr(benchmark::State &state)
+{
+    int i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::speed_to_str(static_cast<sc::SpeedVal>(i - 10)));
+        i = (i + 1) % 21;
+    }
+}
+BENCHMARK(BM_SpeedToStr);
+
+// rounding of continuous setpoints to the nearest step, used by queries
+void BM_SetpointToSpeed(benchmark::State &state)
+{
+    int setpoint = -SETPOINT_MAX;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::setpoint_to_speed(static_cast<sc::Setpoint>(setpoint)));
+        setpoint = (setpoint < SETPOINT_MAX) ? setpoint + 7 : -SETPOINT_MAX;
+    }
+}
+BENCHMARK(BM_SetpointToSpeed);
+
+void BM_SetpointToSteering(benchmark::State &state)
+{
+    int setpoint = -SETPOINT_MAX;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sc::ServoController::setpoint_to_steering(static_cast<sc::Setpoint>(setpoint)));
+        setpoint = (setpoint < SETPOINT_MAX) ? setpoint + 7 : -SETPOINT_MAX;
+    }
+}
+BENCHMARK(BM_SetpointToSteering);
+
+} // namespace servo_controller_bench
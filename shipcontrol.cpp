@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2025 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -30,9 +30,12 @@
 #include <boost/program_options.hpp>
 
 #include "shipcontrol.hpp"
+#include "Clock.hpp"
 #include "GPIOEngineController.hpp"
 #include "GPIOSteeringController.hpp"
 #include "GPIOSwitchConfig.hpp"
+#include "AsyncServoController.hpp"
+#include "SimulatedController.hpp"
 
 extern void signal_handler(int sig);
 
@@ -44,15 +47,29 @@ namespace shipcontrol
 ShipControl::ShipControl() :
     _config(nullptr),
     _evdevReader(nullptr),
-    _speed(SpeedVal::STOP),
-    _steering(SteeringVal::STRAIGHT),
+    _async_log(nullptr),
+    _speed(0),
+    _steering(0),
     _ipcHandler(nullptr),
     _unixListener(nullptr),
+    _metrics_listener(nullptr),
     _stop(false),
+    _maestro_controller(nullptr),
+    _control_loop(nullptr),
     _mode(ShipControlMode::NORMAL),
     _cmd_speed(""),
     _cmd_steering(""),
-    _water_cooling_switch(nullptr)
+    _water_cooling_switch(nullptr),
+    _water_cooling_on(false),
+    _journal(nullptr),
+    _maestro_simulator(nullptr),
+    _maestro_simulator_config(nullptr),
+    _sysfs_pwm_simulator(nullptr),
+    _coalesce_input(true),
+    _events_total(0),
+    _event_batches(0),
+    _events_merged(0),
+    _latency_log_period(0)
 {
     _log = Log::getInstance();
 }
@@ -75,7 +92,15 @@ ShipControl::~ShipControl()
     {
         delete _unixListener;
     }
-    for (ServoController *controller : _servo_controllers)
+    if (_metrics_listener != nullptr)
+    {
+        delete _metrics_listener;
+    }
+    if (_control_loop != nullptr)
+    {
+        delete _control_loop;
+    }
+    for (AsyncServoController *controller : _servo_controllers)
     {
         if (controller != nullptr)
         {
@@ -86,6 +111,29 @@ ShipControl::~ShipControl()
     {
         delete _water_cooling_switch;
     }
+    // simulators are deleted after controllers, which use them until destroyed
+    if (_maestro_simulator_config != nullptr)
+    {
+        delete _maestro_simulator_config;
+    }
+    if (_maestro_simulator != nullptr)
+    {
+        delete _maestro_simulator;
+    }
+    if (_sysfs_pwm_simulator != nullptr)
+    {
+        delete _sysfs_pwm_simulator;
+    }
+    // deleted after controllers, which record their outputs
+    if (_journal != nullptr)
+    {
+        delete _journal;
+    }
+    if (_async_log != nullptr)
+    {
+        _log->remove_backend(_async_log);
+        delete _async_log;
+    }
     Log::release();
 }
 
@@ -156,14 +204,23 @@ int ShipControl::run(int argc, char **argv)
 
     _evdevReader->start();
     _unixListener->start();
+    if (_metrics_listener != nullptr)
+    {
+        _metrics_listener->start();
+    }
 
-    for (ServoController *controller : _servo_controllers)
+    for (AsyncServoController *controller : _servo_controllers)
     {
         controller->start();
     }
 
     if (_mode == ShipControlMode::NORMAL)
     {
+        // time of the next control loop tick, 0 while all outputs are at their targets
+        long long next_tick = 0;
+        // time of the next latency summary, 0 if disabled
+        long long next_summary = (_latency_log_period != 0) ? monotonic_now() + _latency_log_period : 0;
+
         // event handling loop
         while (true)
         {
@@ -172,48 +229,158 @@ int ShipControl::run(int argc, char **argv)
                 break;
             }
 
-            InputEvent evt = _inputQueue.pop_blocking();
-            switch (evt.type)
+            if ((next_summary != 0) && (monotonic_now() >= next_summary))
             {
-            case InputEventType::TURN_RIGHT:
-                turn_right();
-                break;
-            case InputEventType::TURN_LEFT:
-                turn_left();
-                break;
-            case InputEventType::SPEED_UP:
-                speed_up();
-                break;
-            case InputEventType::SPEED_DOWN:
-                speed_down();
-                break;
-            case InputEventType::SET_SPEED:
-                set_speed(evt.data);
-                break;
-            case InputEventType::SET_STEERING:
-                set_steering(evt.data);
-                break;
-            default:
-                break;
+                log_latency_summary();
+                next_summary = monotonic_now() + _latency_log_period;
+            }
+
+            InputEvent evt;
+            if (_control_loop->is_active())
+            {
+                // ramping in progress, wait for input until the next tick
+                long long now = monotonic_now();
+                if (next_tick == 0)
+                {
+                    next_tick = now;
+                }
+                if (now >= next_tick)
+                {
+                    _control_loop->tick();
+                    update_water_cooling();
+                    next_tick += _control_loop->get_tick_period();
+                    if (next_tick <= now)
+                    {
+                        // don't try to catch up with missed ticks
+                        next_tick = now + _control_loop->get_tick_period();
+                    }
+                    continue;
+                }
+                long long deadline = ((next_summary != 0) && (next_summary < next_tick)) ? next_summary : next_tick;
+                if (_inputQueue.pop_until(evt, deadline) == false)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                next_tick = 0;
+                if (next_summary != 0)
+                {
+                    if (_inputQueue.pop_until(evt, next_summary) == false)
+                    {
+                        continue;
+                    }
+                }
+                else
+                {
+                    evt = _inputQueue.pop_blocking();
+                }
+            }
+
+            ControlTarget target{_speed, _steering, false, false};
+            unsigned int batch_size = 0;
+            // input time of the oldest event of the batch
+            long long input_time = 0;
+
+            // in coalescing mode fold all pending events into one target state,
+            // so that a burst of events results in a single actuator update;
+            // batch size is limited to keep the loop responsive under a constant stream
+            do
+            {
+                fold_event(evt, target);
+                journal_command(evt, target);
+                if (evt.type != InputEventType::UNKNOWN)
+                {
+                    // events of a batch are popped one by one, each gets its own pop time
+                    _latency_stats.record(LatencyStage::QUEUE, monotonic_now() - evt.queued);
+                    if ((evt.time != 0) && ((input_time == 0) || (evt.time < input_time)))
+                    {
+                        input_time = evt.time;
+                    }
+                }
+                batch_size++;
+            }
+            while (_coalesce_input &&
+                   (batch_size < _inputQueue.get_capacity()) &&
+                   _inputQueue.try_pop(evt));
+
+            _events_total += batch_size;
+            _event_batches++;
+            if (batch_size > 1)
+            {
+                _events_merged += batch_size - 1;
+                LOG_DEBUG(_log, "ShipControl merged %u input events\n", batch_size);
+            }
+
+            // absolute commands are always applied, relative ones only if they change anything;
+            // controllers take the input time of the batch for measuring total latency
+            bool changed = (target.speed != _speed) || (target.steering != _steering);
+            _latency_stats.set_command_time(input_time);
+            if ((target.speed != _speed) || target.speed_set)
+            {
+                set_speed(target.speed);
+            }
+            if ((target.steering != _steering) || target.steering_set)
+            {
+                set_steering(target.steering);
+            }
+            _latency_stats.set_command_time(0);
+
+            // the query response is rebuilt once per batch, with both axes updated
+            if (changed)
+            {
+                _query_cache.publish(_speed, _steering);
             }
         }
+
+        // controllers log their own stats on destruction
+        _latency_stats.log_summary(_log);
+
+        _log->write(LogLevel::NOTICE,
+                    "ShipControl handled %llu input events in %llu updates, %llu events merged\n",
+                    _events_total, _event_batches, _events_merged);
     }
     else
     {
         // command mode
-        set_speed(_cmd_speed);
-        set_steering(_cmd_steering);
+        InputEvent speed_evt{InputEventType::SET_SPEED};
+        speed_evt.speed = ServoController::speed_to_setpoint(ServoController::str_to_speed(_cmd_speed));
+        speed_evt.source = InputSource::CMDLINE;
+        InputEvent steering_evt{InputEventType::SET_STEERING};
+        steering_evt.steering = ServoController::steering_to_setpoint(ServoController::str_to_steering(_cmd_steering));
+        steering_evt.source = InputSource::CMDLINE;
+        ControlTarget target{speed_evt.speed, steering_evt.steering, true, true};
+        journal_command(speed_evt, target);
+        journal_command(steering_evt, target);
+        bool changed = (target.speed != _speed) || (target.steering != _steering);
+        set_speed(target.speed);
+        set_steering(target.steering);
+        if (changed)
+        {
+            _query_cache.publish(_speed, _steering);
+        }
         std::cout << "Press any key to exit\n";
         std::cin.get();
     }
 
-    for (ServoController *controller : _servo_controllers)
+    for (AsyncServoController *controller : _servo_controllers)
     {
         controller->stop();
     }
 
     _evdevReader->stop();
     _unixListener->stop();
+    if (_metrics_listener != nullptr)
+    {
+        _metrics_listener->stop();
+    }
+
+    if (_inputQueue.get_dropped() != 0)
+    {
+        _log->write(LogLevel::NOTICE, "input queue overflowed, %llu events dropped\n",
+                    static_cast<unsigned long long>(_inputQueue.get_dropped()));
+    }
 
     return RETVAL_OK;
 }
@@ -231,426 +398,283 @@ int ShipControl::init()
 
     // configure logging
     std::vector<LogBackendType> log_backends = _config->get_log_backends();
+    if (_config->get_async_log())
+    {
+        _async_log = new AsyncLog();
+    }
     for (auto backend : log_backends)
     {
+        LogBackend *log_backend = nullptr;
         if (backend == LogBackendType::CONSOLE)
         {
-            _log->add_backend(&_clog);
+            log_backend = &_clog;
         }
         else if (backend == LogBackendType::SYSLOG)
         {
-            _log->add_backend(&_syslog);
+            log_backend = &_syslog;
+        }
+
+        if (_async_log != nullptr)
+        {
+            _async_log->add_target(log_backend);
+        }
+        else if (log_backend != nullptr)
+        {
+            _log->add_backend(log_backend);
         }
     }
+    if (_async_log != nullptr)
+    {
+        _log->add_backend(_async_log);
+    }
     _log->set_level(_config->get_log_level());
 
+    _coalesce_input = _config->get_coalesce_input();
+    _latency_log_period = _config->get_latency_log_period() * 1000000000LL;
+
     // initialize input
     find_input_device(PSMOVEINPUT_DEVICE_NAME, _psmoveinput_dev);
     _evdevReader = new EvdevReader(*_config, _psmoveinput_dev, _inputQueue);
+    _evdevReader->set_latency_stats(&_latency_stats);
+
+    // initialize event journal
+    JournalConfig journal_config = _config->get_journal_config();
+    if (journal_config.is_enabled())
+    {
+        _journal = new Journal(journal_config);
+    }
+
+    SimulationConfig sim_config = _config->get_simulation_config();
+    if (sim_config.is_enabled())
+    {
+        _log->write(LogLevel::NOTICE, "simulation enabled\n");
+    }
 
     // initialize Maestro controller
-    MaestroController *maestro_controller = new MaestroController(*_config);
-    _servo_controllers.push_back(maestro_controller);
+    // every controller applies setpoints from its own worker, so that
+    // slow serial writes to Maestro don't delay GPIO updates
+    MaestroConfig *maestro_config = _config;
+    if (sim_config.maestro)
+    {
+        _maestro_simulator = new MaestroSimulator();
+        if (_maestro_simulator->start())
+        {
+            _maestro_simulator_config = new MaestroSimulatorConfig(*_config, _maestro_simulator->get_dev());
+            maestro_config = _maestro_simulator_config;
+        }
+    }
+    _maestro_controller = new MaestroController(*maestro_config);
+    _servo_controllers.push_back(new AsyncServoController(_maestro_controller, "maestro"));
 
-    // initialize GPIO engine controllers
-    std::vector<GPIOEngineConfig> gpio_engine_configs = _config->get_gpio_engine_configs();
-    for (GPIOEngineConfig gpio_engine_config : gpio_engine_configs)
+    init_gpio_controllers(sim_config);
+
+    for (unsigned int i = 0; i < sim_config.controllers; i++)
     {
-        GPIOEngineController *gpio_engine_controller = new GPIOEngineController(gpio_engine_config);
-        _servo_controllers.push_back(gpio_engine_controller);
+        std::string name = "sim" + std::to_string(i);
+        _servo_controllers.push_back(new AsyncServoController(new SimulatedController(name, sim_config.controller_delay),
+                                     name));
     }
 
-    // initialize GPIO steering controllers
-    std::vector<GPIOSteeringConfig> gpio_steering_configs  =  _config->get_gpio_steering_configs();
-    for (GPIOSteeringConfig gpio_steering_config  : gpio_steering_configs)
+    // command mode exits right after setting targets, so there's nothing to ramp
+    RampConfig ramp_config;
+    if (_mode == ShipControlMode::NORMAL)
+    {
+        ramp_config = _config->get_ramp_config();
+    }
+    std::vector<ServoController*> controllers(_servo_controllers.begin(), _servo_controllers.end());
+    _control_loop = new ControlLoop(ramp_config, controllers);
+
+    for (AsyncServoController *controller : _servo_controllers)
     {
-        GPIOSteeringController *gpio_steering_controller  = new GPIOSteeringController(gpio_steering_config);
-        _servo_controllers.push_back(gpio_steering_controller);
+        controller->set_journal(_journal);
+        controller->set_latency_stats(&_latency_stats);
     }
 
     // initialize water cooling switch
     GPIOSwitchConfig *wc_config = _config->get_water_cooling_relay_config();
-    if (wc_config != nullptr)
+    if ((wc_config != nullptr) && (sim_config.gpio == false))
     {
         _water_cooling_switch = new GPIOSwitch(wc_config->chip_path, wc_config->line_num);
     }
 
     // initialize Unix socket listener
-    _ipcHandler = new IPCRequestHandler(_inputQueue, *this);
+    _query_cache.publish(_speed, _steering);
+    _ipcHandler = new IPCRequestHandler(_inputQueue, *this, &_query_cache);
     _unixListener = new UnixListener(*_config, *_ipcHandler);
 
-    return RETVAL_OK;
-}
+    std::string metrics_socket = _config->get_metrics_socket_name();
+    if (metrics_socket.empty() == false)
+    {
+        _metrics_listener = new MetricsListener(metrics_socket);
+    }
 
-void ShipControl::interrupt()
-{
-    _stop = true;
-    // push dummy event to the input queue, so that run() could detect stop flag
-    _inputQueue.push(InputEvent{InputEventType::UNKNOWN, ""});
+    return RETVAL_OK;
 }
 
-void ShipControl::find_input_device(const char *input_name, std::string &result)
+void ShipControl::init_gpio_controllers(const SimulationConfig &sim_config)
 {
-    dirent *entry;
-    DIR *dir = opendir("/dev/input");
-    if (dir == nullptr)
+    if (sim_config.sysfs_pwm.empty() == false)
     {
-        return;
+        _sysfs_pwm_simulator = new SysfsPWMSimulator(sim_config.sysfs_pwm);
     }
 
-    while ((entry = readdir(dir)) != nullptr)
+    // initialize GPIO engine controllers
+    std::vector<GPIOEngineConfig> gpio_engine_configs = _config->get_gpio_engine_configs();
+    for (GPIOEngineConfig gpio_engine_config : gpio_engine_configs)
     {
-        std::string filename = std::string("/dev/input/") + std::string(entry->d_name);
-        int fd = open(filename.c_str(), O_RDONLY);
-        char name[256];
-        std::memset(name, 0, sizeof (name));
-        ioctl(fd, EVIOCGNAME(sizeof (name)), name);
-        if (std::strncmp(name, input_name, sizeof (name)) == 0)
+        std::string name = "gpio_engine" + std::to_string(gpio_engine_config.engine_line);
+        ServoController *controller = nullptr;
+
+        bool needs_chip = gpio_engine_config.syspwm_path.empty() ||
+                          (gpio_engine_config.reverse_mode == GPIOReverseMode::DEDICATED_LINE);
+        if (sim_config.gpio && needs_chip)
         {
-            result = std::move(filename);
-            _log->write(LogLevel::DEBUG, "found input device %s at %s\n",
-                        input_name, result.c_str());
-            close(fd);
-            break;
+            controller = new SimulatedController(name, sim_config.controller_delay, true, false);
         }
-        close(fd);
+        else
+        {
+            if ((_sysfs_pwm_simulator != nullptr) && (gpio_engine_config.syspwm_path.empty() == false))
+            {
+                gpio_engine_config.syspwm_path = _sysfs_pwm_simulator->add_pwm(gpio_engine_config.syspwm_path,
+                                                                               gpio_engine_config.syspwm_num);
+            }
+            controller = new GPIOEngineController(gpio_engine_config);
+        }
+        _servo_controllers.push_back(new AsyncServoController(controller, name));
     }
 
-    closedir(dir);
-}
-
-void ShipControl::turn_right()
-{
-    SteeringVal new_steering;
-
-    switch (_steering)
+    // initialize GPIO steering controllers
+    std::vector<GPIOSteeringConfig> gpio_steering_configs  =  _config->get_gpio_steering_configs();
+    for (GPIOSteeringConfig gpio_steering_config  : gpio_steering_configs)
     {
-    case SteeringVal::STRAIGHT:
-        new_steering = SteeringVal::RIGHT10;
-        break;
-    case SteeringVal::RIGHT10:
-        new_steering = SteeringVal::RIGHT20;
-        break;
-    case SteeringVal::RIGHT20:
-        new_steering = SteeringVal::RIGHT30;
-        break;
-    case SteeringVal::RIGHT30:
-        new_steering = SteeringVal::RIGHT40;
-        break;
-    case SteeringVal::RIGHT40:
-        new_steering = SteeringVal::RIGHT50;
-        break;
-    case SteeringVal::RIGHT50:
-        new_steering = SteeringVal::RIGHT60;
-        break;
-    case SteeringVal::RIGHT60:
-        new_steering = SteeringVal::RIGHT70;
-        break;
-    case SteeringVal::RIGHT70:
-        new_steering = SteeringVal::RIGHT80;
-        break;
-    case SteeringVal::RIGHT80:
-        new_steering = SteeringVal::RIGHT90;
-        break;
-    case SteeringVal::RIGHT90:
-        new_steering = SteeringVal::RIGHT100;
-        break;
-    case SteeringVal::LEFT10:
-        new_steering = SteeringVal::STRAIGHT;
-        break;
-    case SteeringVal::LEFT20:
-        new_steering = SteeringVal::LEFT10;
-        break;
-    case SteeringVal::LEFT30:
-        new_steering = SteeringVal::LEFT20;
-        break;
-    case SteeringVal::LEFT40:
-        new_steering = SteeringVal::LEFT30;
-        break;
-    case SteeringVal::LEFT50:
-        new_steering = SteeringVal::LEFT40;
-        break;
-    case SteeringVal::LEFT60:
-        new_steering = SteeringVal::LEFT50;
-        break;
-    case SteeringVal::LEFT70:
-        new_steering = SteeringVal::LEFT60;
-        break;
-    case SteeringVal::LEFT80:
-        new_steering = SteeringVal::LEFT70;
-        break;
-    case SteeringVal::LEFT90:
-        new_steering = SteeringVal::LEFT80;
-        break;
-    case SteeringVal::LEFT100:
-        new_steering = SteeringVal::LEFT90;
-        break;
-    default:
-        return;
-    }
+        std::string name = "gpio_steering" + std::to_string(gpio_steering_config.steering_line);
+        ServoController *controller = nullptr;
 
-    for (ServoController *controller : _servo_controllers)
-    {
-        controller->set_steering(new_steering);
+        if (sim_config.gpio && gpio_steering_config.syspwm_path.empty())
+        {
+            controller = new SimulatedController(name, sim_config.controller_delay, false, true);
+        }
+        else
+        {
+            if ((_sysfs_pwm_simulator != nullptr) && (gpio_steering_config.syspwm_path.empty() == false))
+            {
+                gpio_steering_config.syspwm_path = _sysfs_pwm_simulator->add_pwm(gpio_steering_config.syspwm_path,
+                                                                                 gpio_steering_config.syspwm_num);
+            }
+            controller = new GPIOSteeringController(gpio_steering_config);
+        }
+        _servo_controllers.push_back(new AsyncServoController(controller, name));
     }
-    _steering = new_steering;
 }
 
-void ShipControl::turn_left()
+void ShipControl::interrupt()
 {
-    SteeringVal new_steering;
+    _stop = true;
+    // push dummy event to the input queue, so that run() could detect stop flag
+    _inputQueue.push(InputEvent{InputEventType::UNKNOWN});
+}
 
-    switch (_steering)
+void ShipControl::fold_event(const InputEvent &evt, ControlTarget &target)
+{
+    switch (evt.type)
     {
-    case SteeringVal::STRAIGHT:
-        new_steering = SteeringVal::LEFT10;
-        break;
-    case SteeringVal::RIGHT10:
-        new_steering = SteeringVal::STRAIGHT;
-        break;
-    case SteeringVal::RIGHT20:
-        new_steering = SteeringVal::RIGHT10;
-        break;
-    case SteeringVal::RIGHT30:
-        new_steering = SteeringVal::RIGHT20;
-        break;
-    case SteeringVal::RIGHT40:
-        new_steering = SteeringVal::RIGHT30;
-        break;
-    case SteeringVal::RIGHT50:
-        new_steering = SteeringVal::RIGHT40;
+    case InputEventType::TURN_RIGHT:
+        target.steering = ServoController::clamp_setpoint(target.steering + SETPOINT_STEP);
         break;
-    case SteeringVal::RIGHT60:
-        new_steering = SteeringVal::RIGHT50;
+    case InputEventType::TURN_LEFT:
+        target.steering = ServoController::clamp_setpoint(target.steering - SETPOINT_STEP);
         break;
-    case SteeringVal::RIGHT70:
-        new_steering = SteeringVal::RIGHT60;
+    case InputEventType::SPEED_UP:
+        target.speed = ServoController::clamp_setpoint(target.speed + SETPOINT_STEP);
         break;
-    case SteeringVal::RIGHT80:
-        new_steering = SteeringVal::RIGHT70;
+    case InputEventType::SPEED_DOWN:
+        target.speed = ServoController::clamp_setpoint(target.speed - SETPOINT_STEP);
         break;
-    case SteeringVal::RIGHT90:
-        new_steering = SteeringVal::RIGHT80;
+    case InputEventType::SET_SPEED:
+        target.speed = ServoController::clamp_setpoint(evt.speed);
+        target.speed_set = true;
         break;
-    case SteeringVal::RIGHT100:
-        new_steering = SteeringVal::RIGHT90;
-        break;
-    case SteeringVal::LEFT10:
-        new_steering = SteeringVal::LEFT20;
-        break;
-    case SteeringVal::LEFT20:
-        new_steering = SteeringVal::LEFT30;
-        break;
-    case SteeringVal::LEFT30:
-        new_steering = SteeringVal::LEFT40;
-        break;
-    case SteeringVal::LEFT40:
-        new_steering = SteeringVal::LEFT50;
-        break;
-    case SteeringVal::LEFT50:
-        new_steering = SteeringVal::LEFT60;
-        break;
-    case SteeringVal::LEFT60:
-        new_steering = SteeringVal::LEFT70;
-        break;
-    case SteeringVal::LEFT70:
-        new_steering = SteeringVal::LEFT80;
-        break;
-    case SteeringVal::LEFT80:
-        new_steering = SteeringVal::LEFT90;
-        break;
-    case SteeringVal::LEFT90:
-        new_steering = SteeringVal::LEFT100;
+    case InputEventType::SET_STEERING:
+        target.steering = ServoController::clamp_setpoint(evt.steering);
+        target.steering_set = true;
         break;
     default:
-        return;
-    }
-
-    for (ServoController *controller : _servo_controllers)
-    {
-        controller->set_steering(new_steering);
+        break;
     }
-    _steering = new_steering;
 }
 
-void ShipControl::speed_up()
+void ShipControl::journal_command(const InputEvent &evt, const ControlTarget &target)
 {
-    SpeedVal new_speed;
-
-    switch (_speed)
+    if ((_journal == nullptr) || (evt.type == InputEventType::UNKNOWN))
     {
-    case SpeedVal::STOP:
-        new_speed = SpeedVal::FWD10;
-        break;
-    case SpeedVal::FWD10:
-        new_speed = SpeedVal::FWD20;
-        break;
-    case SpeedVal::FWD20:
-        new_speed = SpeedVal::FWD30;
-        break;
-    case SpeedVal::FWD30:
-        new_speed = SpeedVal::FWD40;
-        break;
-    case SpeedVal::FWD40:
-        new_speed = SpeedVal::FWD50;
-        break;
-    case SpeedVal::FWD50:
-        new_speed = SpeedVal::FWD60;
-        break;
-    case SpeedVal::FWD60:
-        new_speed = SpeedVal::FWD70;
-        break;
-    case SpeedVal::FWD70:
-        new_speed = SpeedVal::FWD80;
-        break;
-    case SpeedVal::FWD80:
-        new_speed = SpeedVal::FWD90;
-        break;
-    case SpeedVal::FWD90:
-        new_speed = SpeedVal::FWD100;
-        break;
-    case SpeedVal::REV10:
-        new_speed = SpeedVal::STOP;
-        break;
-    case SpeedVal::REV20:
-        new_speed = SpeedVal::REV10;
-        break;
-    case SpeedVal::REV30:
-        new_speed = SpeedVal::REV20;
-        break;
-    case SpeedVal::REV40:
-        new_speed = SpeedVal::REV30;
-        break;
-    case SpeedVal::REV50:
-        new_speed = SpeedVal::REV40;
-        break;
-    case SpeedVal::REV60:
-        new_speed = SpeedVal::REV50;
-        break;
-    case SpeedVal::REV70:
-        new_speed = SpeedVal::REV60;
-        break;
-    case SpeedVal::REV80:
-        new_speed = SpeedVal::REV70;
-        break;
-    case SpeedVal::REV90:
-        new_speed = SpeedVal::REV80;
-        break;
-    case SpeedVal::REV100:
-        new_speed = SpeedVal::REV90;
-        break;
-    default:
         return;
     }
 
-    set_water_cooling(new_speed);
+    bool is_speed = (evt.type == InputEventType::SPEED_UP) ||
+                    (evt.type == InputEventType::SPEED_DOWN) ||
+                    (evt.type == InputEventType::SET_SPEED);
+    _journal->record_command(evt.source, evt.type, is_speed ? target.speed : target.steering);
+}
 
-    for (ServoController *controller : _servo_controllers)
+void ShipControl::log_latency_summary()
+{
+    _latency_stats.log_summary(_log);
+    for (AsyncServoController *controller : _servo_controllers)
     {
-        controller->set_speed(new_speed);
+        controller->log_latency_stats();
     }
-    _speed = new_speed;
 }
 
-void ShipControl::speed_down()
+void ShipControl::find_input_device(const char *input_name, std::string &result)
 {
-    SpeedVal new_speed;
-
-    switch (_speed)
+    dirent *entry;
+    DIR *dir = opendir("/dev/input");
+    if (dir == nullptr)
     {
-    case SpeedVal::STOP:
-        new_speed = SpeedVal::REV10;
-        break;
-    case SpeedVal::FWD10:
-        new_speed = SpeedVal::STOP;
-        break;
-    case SpeedVal::FWD20:
-        new_speed = SpeedVal::FWD10;
-        break;
-    case SpeedVal::FWD30:
-        new_speed = SpeedVal::FWD20;
-        break;
-    case SpeedVal::FWD40:
-        new_speed = SpeedVal::FWD30;
-        break;
-    case SpeedVal::FWD50:
-        new_speed = SpeedVal::FWD40;
-        break;
-    case SpeedVal::FWD60:
-        new_speed = SpeedVal::FWD50;
-        break;
-    case SpeedVal::FWD70:
-        new_speed = SpeedVal::FWD60;
-        break;
-    case SpeedVal::FWD80:
-        new_speed = SpeedVal::FWD70;
-        break;
-    case SpeedVal::FWD90:
-        new_speed = SpeedVal::FWD80;
-        break;
-    case SpeedVal::FWD100:
-        new_speed = SpeedVal::FWD90;
-        break;
-    case SpeedVal::REV10:
-        new_speed = SpeedVal::REV20;
-        break;
-    case SpeedVal::REV20:
-        new_speed = SpeedVal::REV30;
-        break;
-    case SpeedVal::REV30:
-        new_speed = SpeedVal::REV40;
-        break;
-    case SpeedVal::REV40:
-        new_speed = SpeedVal::REV50;
-        break;
-    case SpeedVal::REV50:
-        new_speed = SpeedVal::REV60;
-        break;
-    case SpeedVal::REV60:
-        new_speed = SpeedVal::REV70;
-        break;
-    case SpeedVal::REV70:
-        new_speed = SpeedVal::REV80;
-        break;
-    case SpeedVal::REV80:
-        new_speed = SpeedVal::REV90;
-        break;
-    case SpeedVal::REV90:
-        new_speed = SpeedVal::REV100;
-        break;
-    default:
         return;
     }
 
-    set_water_cooling(new_speed);
-
-    for (ServoController *controller : _servo_controllers)
+    while ((entry = readdir(dir)) != nullptr)
     {
-        controller->set_speed(new_speed);
+        std::string filename = std::string("/dev/input/") + std::string(entry->d_name);
+        int fd = open(filename.c_str(), O_RDONLY);
+        char name[256];
+        std::memset(name, 0, sizeof (name));
+        ioctl(fd, EVIOCGNAME(sizeof (name)), name);
+        if (std::strncmp(name, input_name, sizeof (name)) == 0)
+        {
+            result = std::move(filename);
+            LOG_DEBUG(_log, "found input device %s at %s\n",
+                        input_name, result.c_str());
+            close(fd);
+            break;
+        }
+        close(fd);
     }
-    _speed = new_speed;
-}
 
+    closedir(dir);
+}
 
-void ShipControl::set_speed(const std::string &speed_str)
+void ShipControl::set_speed(Setpoint new_speed)
 {
-    SpeedVal new_speed = ServoController::str_to_speed(speed_str);
-    set_water_cooling(new_speed);
-    for (ServoController *controller : _servo_controllers)
-    {
-        controller->set_speed(new_speed);
-    }
+    _control_loop->set_speed_target(new_speed);
     _speed = new_speed;
+    update_water_cooling();
+}
+
+void ShipControl::set_steering(Setpoint new_steering)
+{
+    _control_loop->set_steering_target(new_steering);
+    _steering = new_steering;
 }
 
-void ShipControl::set_steering(const std::string &steering_str)
+bool ShipControl::get_maestro_telemetry(MaestroTelemetryData &data)
 {
-    SteeringVal new_steering = ServoController::str_to_steering(steering_str);
-    for (ServoController *controller : _servo_controllers)
+    if (_maestro_controller == nullptr)
     {
-        controller->set_steering(new_steering);
+        return false;
     }
-    _steering = new_steering;
+    return _maestro_controller->get_telemetry(data);
 }
 
 void ShipControl::setup_signals()
@@ -681,7 +705,7 @@ void ShipControl::setup_signals()
     sigaction(SIGPIPE, &ignore_act, nullptr);
 }
 
-void ShipControl::set_water_cooling(SpeedVal speed)
+void ShipControl::update_water_cooling()
 {
     if (_water_cooling_switch == nullptr)
     {
@@ -692,14 +716,22 @@ void ShipControl::set_water_cooling(SpeedVal speed)
         return;
     }
 
-    if (speed == SpeedVal::STOP)
+    // cooling is switched on together with the engines, but is kept on
+    // while they are still ramping down to stop
+    bool on = (_speed != 0) || (_control_loop->get_speed_output() != 0);
+    if (on == _water_cooling_on)
     {
-        _water_cooling_switch->off();
+        return;
     }
-    else
+    _water_cooling_on = on;
+    if (on)
     {
         _water_cooling_switch->on();
     }
+    else
+    {
+        _water_cooling_switch->off();
+    }
 }
 
 } // namespace shipcontrol
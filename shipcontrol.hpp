@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2025 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -29,9 +29,17 @@
 #include "MaestroController.hpp"
 #include "ConsoleLog.hpp"
 #include "SysLog.hpp"
+#include "AsyncLog.hpp"
 #include "DataProvider.hpp"
 #include "UnixListener.hpp"
+#include "MetricsListener.hpp"
 #include "GPIOSwitch.hpp"
+#include "QueryCache.hpp"
+#include "ControlLoop.hpp"
+#include "AsyncServoController.hpp"
+#include "Journal.hpp"
+#include "MaestroSimulator.hpp"
+#include "SysfsPWMSimulator.hpp"
 
 namespace shipcontrol
 {
@@ -55,6 +63,16 @@ enum class ShipControlMode
     HELP
 };
 
+// target state accumulated from one or more input events
+struct ControlTarget
+{
+    Setpoint speed;
+    Setpoint steering;
+    // true if the target has been set by an absolute command
+    bool speed_set;
+    bool steering_set;
+};
+
 class ShipControl : public DataProvider
 {
 public:
@@ -65,8 +83,13 @@ public:
     void interrupt();
 
     // DataProvider implementation
-    virtual SpeedVal get_speed() { return _speed; }
-    virtual SteeringVal get_steering() { return _steering; }
+    virtual Setpoint get_speed_setpoint() { return _speed; }
+    virtual Setpoint get_steering_setpoint() { return _steering; }
+    virtual bool get_maestro_telemetry(MaestroTelemetryData &data);
+    virtual LatencyStats *get_latency_stats() { return &_latency_stats; }
+
+    // fold the input event into the target state of its batch
+    static void fold_event(const InputEvent &evt, ControlTarget &target);
 
 protected:
     Config *_config;
@@ -76,29 +99,57 @@ protected:
     Log *_log;
     ConsoleLog _clog;
     SysLog _syslog;
-    SpeedVal _speed;
-    SteeringVal _steering;
+    // drains log messages to _clog and _syslog in the background, if enabled
+    AsyncLog *_async_log;
+    Setpoint _speed;
+    Setpoint _steering;
+    // serialized status for IPC queries, republished once per applied batch that changes it
+    QueryCache _query_cache;
     IPCRequestHandler *_ipcHandler;
     UnixListener *_unixListener;
+    // nullptr if metrics are not exported
+    MetricsListener *_metrics_listener;
     bool _stop;
-    std::vector<ServoController*> _servo_controllers;
+    // every controller is wrapped to apply setpoints from its own worker
+    std::vector<AsyncServoController*> _servo_controllers;
+    // owned by its AsyncServoController in _servo_controllers, used for telemetry queries
+    MaestroController *_maestro_controller;
+    // ramps setpoints toward targets, ticked from the event loop
+    ControlLoop *_control_loop;
     ShipControlMode _mode;
     // used in command mode only
     std::string _cmd_speed;
     std::string _cmd_steering;
     GPIOSwitch *_water_cooling_switch;
+    // state of the water cooling relay, which is off on startup
+    bool _water_cooling_on;
+    // journal of commands and controller outputs, nullptr if disabled
+    Journal *_journal;
+    // simulation backends, nullptr if not simulated
+    MaestroSimulator *_maestro_simulator;
+    MaestroSimulatorConfig *_maestro_simulator_config;
+    SysfsPWMSimulator *_sysfs_pwm_simulator;
+    // fold pending input events into a single update
+    bool _coalesce_input;
+    // input event statistics
+    unsigned long long _events_total;
+    unsigned long long _event_batches;
+    unsigned long long _events_merged;
+    // input-to-actuation latency by stage
+    LatencyStats _latency_stats;
+    // period of logging latency summary in nanoseconds, 0 if disabled
+    long long _latency_log_period;
 
     int handle_cmd_line(int argc, char **argv);
     int init();
+    void init_gpio_controllers(const SimulationConfig &sim_config);
     void find_input_device(const char *input_name, std::string &result);
-    void turn_right();
-    void turn_left();
-    void speed_up();
-    void speed_down();
-    void set_speed(const std::string &speed_str);
-    void set_steering(const std::string &steering_str);
+    void journal_command(const InputEvent &evt, const ControlTarget &target);
+    void log_latency_summary();
+    void set_speed(Setpoint new_speed);
+    void set_steering(Setpoint new_steering);
     void setup_signals();
-    void set_water_cooling(SpeedVal speed);
+    void update_water_cooling();
 };
 
 } // namespace shipcontrol
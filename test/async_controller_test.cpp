@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "AsyncServoController.hpp"
+#include "Clock.hpp"
+
+namespace sc = shipcontrol;
+
+namespace async_controller_test
+{
+
+// controller, which blocks in setters until released by the test
+class SlowController : public sc::ServoController
+{
+public:
+    SlowController(std::vector<sc::Setpoint> *destroyed_steering = nullptr) :
+        _destroyed_steering(destroyed_steering) {}
+    virtual ~SlowController()
+    {
+        if (_destroyed_steering != nullptr)
+        {
+            *_destroyed_steering = _steering;
+        }
+    }
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual sc::Setpoint get_speed_setpoint() { return 0; }
+    virtual void set_speed_setpoint(sc::Setpoint speed)
+    {
+        std::lock_guard<std::mutex> lock(_gate);
+        std::lock_guard<std::mutex> values_lock(_values_mutex);
+        _speed.push_back(speed);
+    }
+    virtual sc::Setpoint get_steering_setpoint() { return 0; }
+    virtual void set_steering_setpoint(sc::Setpoint steering)
+    {
+        std::lock_guard<std::mutex> lock(_gate);
+        std::lock_guard<std::mutex> values_lock(_values_mutex);
+        _steering.push_back(steering);
+    }
+
+    std::vector<sc::Setpoint> get_speed_values()
+    {
+        std::lock_guard<std::mutex> lock(_values_mutex);
+        return _speed;
+    }
+
+    std::vector<sc::Setpoint> *_destroyed_steering;
+    std::mutex _gate;
+    std::mutex _values_mutex;
+    std::vector<sc::Setpoint> _speed;
+    std::vector<sc::Setpoint> _steering;
+};
+
+// controller driving steering only, like GPIO steering controllers
+class SteeringController : public SlowController
+{
+public:
+    virtual bool drives_speed() { return false; }
+};
+
+TEST(AsyncServoController, LatestWins)
+{
+    SlowController *slow = new SlowController();
+    sc::AsyncServoController controller(slow, "slow");
+
+    // block the worker in the first apply
+    slow->_gate.lock();
+    controller.set_speed_setpoint(100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // setters don't wait for the blocked worker, newer values replace older ones
+    controller.set_speed_setpoint(200);
+    controller.set_speed_setpoint(300);
+    controller.set_speed_setpoint(400);
+    ASSERT_EQ(400, controller.get_speed_setpoint());
+    slow->_gate.unlock();
+
+    for (int i = 0; (i < 500) && (slow->get_speed_values().size() < 2); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(std::vector<sc::Setpoint>({100, 400}), slow->get_speed_values());
+    ASSERT_EQ(2, controller.get_replaced());
+    ASSERT_EQ(2, controller.get_latency_stats().get_count());
+    // the second setpoint waited for the blocked apply
+    ASSERT_GE(controller.get_latency_stats().get_max(), 20000000);
+}
+
+TEST(AsyncServoController, FlushOnDestroy)
+{
+    std::vector<sc::Setpoint> steering;
+    SlowController *slow = new SlowController(&steering);
+    {
+        sc::AsyncServoController controller(slow, "slow");
+        slow->_gate.lock();
+        controller.set_steering_setpoint(-500);
+        controller.set_speed_setpoint(700);
+        controller.set_steering_setpoint(-600);
+        slow->_gate.unlock();
+    }
+    // pending setpoints are applied before the wrapped controller is destroyed
+    ASSERT_FALSE(steering.empty());
+    ASSERT_EQ(-600, steering.back());
+}
+
+// total latency is measured from the input time of the command being handled
+TEST(AsyncServoController, SharedLatencyStats)
+{
+    sc::LatencyStats stats;
+    SlowController *slow = new SlowController();
+    {
+        sc::AsyncServoController controller(slow, "slow");
+        controller.set_latency_stats(&stats);
+
+        // input happened 5 ms ago
+        stats.set_command_time(sc::monotonic_now() - 5000000);
+        controller.set_speed_setpoint(100);
+        stats.set_command_time(0);
+        // setpoint without known input, e.g. a ramp step
+        controller.set_steering_setpoint(200);
+    }
+
+    ASSERT_EQ(2, stats.get(sc::LatencyStage::APPLY).get_count());
+    ASSERT_EQ(1, stats.get(sc::LatencyStage::TOTAL).get_count());
+    ASSERT_GE(stats.get(sc::LatencyStage::TOTAL).get_max(), 5000000);
+}
+
+// outputs are journaled only for the axes driven by the controller
+TEST(AsyncServoController, JournalDrivenAxes)
+{
+    char tmpl[] = "/tmp/scjournalXXXXXX";
+    int fd = mkstemp(tmpl);
+    ASSERT_NE(-1, fd);
+    close(fd);
+    sc::JournalConfig config;
+    config.path = tmpl;
+    config.entries = 16;
+
+    {
+        sc::Journal journal(config);
+        sc::AsyncServoController controller(new SteeringController(), "steering");
+        ASSERT_FALSE(controller.drives_speed());
+        ASSERT_TRUE(controller.drives_steering());
+        controller.set_journal(&journal);
+        controller.set_speed_setpoint(300);
+        controller.set_steering_setpoint(-200);
+    }
+
+    std::vector<sc::JournalEntry> entries;
+    ASSERT_TRUE(sc::Journal::read(config.path, entries));
+    unlink(tmpl);
+    ASSERT_EQ(1, entries.size());
+    ASSERT_EQ(sc::JournalEntryKind::STEERING_OUTPUT, entries[0].kind);
+    ASSERT_EQ(-200, entries[0].setpoint);
+}
+
+// total latency of a command is recorded once, however many controllers it updates,
+// and latency is recorded only for the driven axes
+TEST(AsyncServoController, TotalLatencyOncePerCommand)
+{
+    sc::LatencyStats stats;
+    {
+        sc::AsyncServoController engines(new SlowController(), "engines");
+        sc::AsyncServoController steering(new SteeringController(), "steering");
+        engines.set_latency_stats(&stats);
+        steering.set_latency_stats(&stats);
+
+        stats.set_command_time(sc::monotonic_now());
+        engines.set_speed_setpoint(100);
+        steering.set_speed_setpoint(100);
+        engines.set_steering_setpoint(200);
+        steering.set_steering_setpoint(200);
+        stats.set_command_time(0);
+    }
+
+    // speed and steering of "engines", steering of "steering"
+    ASSERT_EQ(3, stats.get(sc::LatencyStage::APPLY).get_count());
+    ASSERT_EQ(1, stats.get(sc::LatencyStage::TOTAL).get_count());
+}
+
+} // namespace async_controller_test
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AsyncLog.hpp"
+
+namespace sc = shipcontrol;
+
+namespace async_log_test
+{
+
+// collects formatted messages, may be written from the flusher thread
+class TestBackend : public sc::LogBackend
+{
+public:
+    virtual void write(const char *fmt, va_list args)
+    {
+        char buf[512];
+        vsnprintf(buf, sizeof(buf), fmt, args);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _messages.push_back(buf);
+    }
+
+    std::vector<std::string> get_messages()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _messages;
+    }
+
+    std::mutex _mutex;
+    std::vector<std::string> _messages;
+};
+
+static void log_write(sc::AsyncLog &log, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    log.write(fmt, args);
+    va_end(args);
+}
+
+TEST(AsyncLog, PerThreadOrder)
+{
+    TestBackend backend;
+    // drained explicitly
+    sc::AsyncLog log(128, 10000);
+    log.add_target(&backend);
+
+    auto writer = [&log](int id)
+    {
+        for (int i = 0; i < 50; i++)
+        {
+            log_write(log, "%d %d\n", id, i);
+        }
+    };
+    std::thread t1(writer, 1);
+    std::thread t2(writer, 2);
+    t1.join();
+    t2.join();
+    log.flush();
+
+    std::vector<std::string> messages = backend.get_messages();
+    ASSERT_EQ(100, messages.size());
+    int next[3] = { 0, 0, 0 };
+    for (const std::string &message : messages)
+    {
+        int id = -1;
+        int i = -1;
+        ASSERT_EQ(2, sscanf(message.c_str(), "%d %d", &id, &i));
+        ASSERT_TRUE((id == 1) || (id == 2));
+        ASSERT_EQ(next[id], i);
+        next[id]++;
+    }
+    ASSERT_EQ(0, log.get_dropped());
+}
+
+TEST(AsyncLog, Overflow)
+{
+    TestBackend backend;
+    sc::AsyncLog log(8, 10000);
+    log.add_target(&backend);
+
+    for (int i = 0; i < 20; i++)
+    {
+        log_write(log, "message %d\n", i);
+    }
+    ASSERT_EQ(12, log.get_dropped());
+    log.flush();
+
+    std::vector<std::string> messages = backend.get_messages();
+    ASSERT_EQ(9, messages.size());
+    ASSERT_EQ("message 0\n", messages[0]);
+    ASSERT_EQ("message 7\n", messages[7]);
+    ASSERT_EQ("AsyncLog dropped 12 messages\n", messages[8]);
+
+    // ring is reusable after draining, drops are reported once
+    log_write(log, "message %d\n", 20);
+    log.flush();
+    messages = backend.get_messages();
+    ASSERT_EQ(10, messages.size());
+    ASSERT_EQ("message 20\n", messages[9]);
+}
+
+TEST(AsyncLog, Truncation)
+{
+    TestBackend backend;
+    sc::AsyncLog log(8, 10000);
+    log.add_target(&backend);
+
+    std::string long_message(ASYNC_LOG_RECORD_SIZE * 2, 'x');
+    log_write(log, "%s", long_message.c_str());
+    log.flush();
+
+    std::vector<std::string> messages = backend.get_messages();
+    ASSERT_EQ(1, messages.size());
+    ASSERT_EQ(ASYNC_LOG_RECORD_SIZE - 1, messages[0].size());
+}
+
+TEST(AsyncLog, BackgroundFlush)
+{
+    TestBackend backend;
+    {
+        sc::AsyncLog log;
+        log.add_target(&backend);
+
+        log_write(log, "first\n");
+        for (int i = 0; (i < 100) && backend.get_messages().empty(); i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(1, backend.get_messages().size());
+
+        // drained on destruction
+        log_write(log, "last\n");
+    }
+
+    std::vector<std::string> messages = backend.get_messages();
+    ASSERT_EQ(2, messages.size());
+    ASSERT_EQ("last\n", messages[1]);
+}
+
+} // namespace async_log_test
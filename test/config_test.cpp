@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2025 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -81,9 +81,12 @@ TEST(Config, ConfigTest)
     ASSERT_EQ(1900, dir_high);
     int dir_low = config.get_direction_low();
     ASSERT_EQ(800, dir_low);
+    ASSERT_TRUE(config.get_multi_target());
+    ASSERT_EQ(200, config.get_telemetry_period());
 
     std::string unix_socket = config.get_unix_socket_name();
     ASSERT_EQ("/tmp/scsocket", unix_socket);
+    ASSERT_EQ("/tmp/scmetrics", config.get_metrics_socket_name());
 
     std::vector<sc::GPIOEngineConfig> gpio_engine_configs = config.get_gpio_engine_configs();
     ASSERT_EQ(4, gpio_engine_configs.size());
@@ -112,6 +115,9 @@ TEST(Config, ConfigTest)
     ASSERT_EQ(5, gpio_engine_configs[3].min_duty_cycle);
     ASSERT_EQ(65, gpio_engine_configs[3].max_duty_cycle);
     ASSERT_EQ(sc::GPIOReverseMode::DEDICATED_LINE, gpio_engine_configs[3].reverse_mode);
+    ASSERT_EQ(80, gpio_engine_configs[3].pwm_realtime.priority);
+    ASSERT_EQ(3, gpio_engine_configs[3].pwm_realtime.cpu);
+    ASSERT_TRUE(gpio_engine_configs[3].pwm_realtime.lock_memory);
 
     std::vector<sc::GPIOSteeringConfig> gpio_steering_configs = config.get_gpio_steering_configs();
     ASSERT_EQ(2, gpio_steering_configs.size());
@@ -126,6 +132,7 @@ TEST(Config, ConfigTest)
     ASSERT_EQ(16600, gpio_steering_configs[1].pwm_period);
     ASSERT_EQ(6, gpio_steering_configs[1].min_duty_cycle);
     ASSERT_EQ(12, gpio_steering_configs[1].max_duty_cycle);
+    ASSERT_EQ(80, gpio_steering_configs[1].pwm_realtime.priority);
 
     sc::GPIOSwitchConfig *wc_config = config.get_water_cooling_relay_config();
     ASSERT_FALSE(wc_config == nullptr);
@@ -139,6 +146,31 @@ TEST(Config, ConfigTest)
 
     sc::LogLevel log_level = config.get_log_level();
     ASSERT_EQ(sc::LogLevel::NOTICE, log_level);
+    ASSERT_FALSE(config.get_async_log());
+    ASSERT_EQ(300, config.get_latency_log_period());
+
+    ASSERT_FALSE(config.get_coalesce_input());
+
+    sc::RampConfig ramp = config.get_ramp_config();
+    ASSERT_EQ(100, ramp.tick_rate);
+    ASSERT_EQ(500, ramp.speed.rate);
+    ASSERT_EQ(1000, ramp.speed.accel);
+    ASSERT_EQ(2000, ramp.steering.rate);
+    ASSERT_EQ(0, ramp.steering.accel);
+
+    sc::JournalConfig journal = config.get_journal_config();
+    ASSERT_TRUE(journal.is_enabled());
+    ASSERT_EQ("/tmp/shipcontrol.journal", journal.path);
+    ASSERT_EQ(1024, journal.entries);
+    ASSERT_EQ(1000, journal.sync_period);
+
+    sc::SimulationConfig simulation = config.get_simulation_config();
+    ASSERT_TRUE(simulation.is_enabled());
+    ASSERT_FALSE(simulation.gpio);
+    ASSERT_EQ(2, simulation.controllers);
+    ASSERT_EQ(500, simulation.controller_delay);
+    ASSERT_TRUE(simulation.maestro);
+    ASSERT_EQ("/dev/shm/shipcontrol-sysfs", simulation.sysfs_pwm);
 }
 
 } // namespace config_test
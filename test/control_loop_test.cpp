@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "ControlLoop.hpp"
+
+namespace sc = shipcontrol;
+
+namespace control_loop_test
+{
+
+// records setpoints pushed by the control loop
+class RampTestController : public sc::ServoController
+{
+public:
+    RampTestController(bool hw_ramp) : _hw_ramp(hw_ramp) {}
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual sc::Setpoint get_speed_setpoint() { return _speed.empty() ? 0 : _speed.back(); }
+    virtual void set_speed_setpoint(sc::Setpoint speed) { _speed.push_back(speed); }
+    virtual sc::Setpoint get_steering_setpoint() { return _steering.empty() ? 0 : _steering.back(); }
+    virtual void set_steering_setpoint(sc::Setpoint steering) { _steering.push_back(steering); }
+    virtual bool set_ramp(const sc::RampConfig &/*config*/) { return _hw_ramp; }
+
+    bool _hw_ramp;
+    std::vector<sc::Setpoint> _speed;
+    std::vector<sc::Setpoint> _steering;
+};
+
+TEST(ServoRamp, Rate)
+{
+    // 500 per second at 10 ticks per second
+    sc::ServoRamp ramp(sc::RampLimits{500, 0}, 10);
+
+    ramp.set_target(-120);
+    ASSERT_TRUE(ramp.tick());
+    ASSERT_EQ(-50, ramp.get_output());
+    ASSERT_TRUE(ramp.tick());
+    ASSERT_EQ(-100, ramp.get_output());
+    ASSERT_FALSE(ramp.is_settled());
+    ASSERT_TRUE(ramp.tick());
+    ASSERT_EQ(-120, ramp.get_output());
+    ASSERT_TRUE(ramp.is_settled());
+    ASSERT_FALSE(ramp.tick());
+}
+
+TEST(ServoRamp, Acceleration)
+{
+    sc::ServoRamp ramp(sc::RampLimits{0, 1000}, 50);
+    ramp.set_target(1000);
+
+    // speeds up, slows down and stops at the target without overshooting
+    int ticks = 0;
+    sc::Setpoint prev = 0;
+    int max_step = 0;
+    while ((ramp.is_settled() == false) && (ticks < 1000))
+    {
+        ramp.tick();
+        ASSERT_GE(ramp.get_output(), prev);
+        ASSERT_LE(ramp.get_output(), 1000);
+        max_step = std::max(max_step, ramp.get_output() - prev);
+        prev = ramp.get_output();
+        ticks++;
+    }
+    ASSERT_EQ(1000, ramp.get_output());
+    // 1000 per-mille at 1000 per second squared takes 2 seconds
+    ASSERT_GE(ticks, 95);
+    ASSERT_LE(ticks, 110);
+    ASSERT_LE(max_step, 21);
+}
+
+TEST(ControlLoop, Outputs)
+{
+    sc::RampConfig config;
+    config.tick_rate = 10;
+    config.speed.rate = 1000;
+
+    RampTestController sw_controller(false);
+    RampTestController hw_controller(true);
+    std::vector<sc::ServoController*> controllers = { &sw_controller, &hw_controller };
+    sc::ControlLoop loop(config, controllers);
+    ASSERT_EQ(100000000, loop.get_tick_period());
+    ASSERT_FALSE(loop.is_active());
+
+    // hardware ramping controller gets the target right away
+    loop.set_speed_target(250);
+    ASSERT_EQ(std::vector<sc::Setpoint>({250}), hw_controller._speed);
+    ASSERT_TRUE(sw_controller._speed.empty());
+    ASSERT_TRUE(loop.is_active());
+
+    // steering isn't limited, so it isn't delayed until the next tick
+    loop.set_steering_target(-300);
+    ASSERT_EQ(std::vector<sc::Setpoint>({-300}), sw_controller._steering);
+    ASSERT_EQ(std::vector<sc::Setpoint>({-300}), hw_controller._steering);
+
+    while (loop.is_active())
+    {
+        loop.tick();
+    }
+    ASSERT_EQ(std::vector<sc::Setpoint>({100, 200, 250}), sw_controller._speed);
+    ASSERT_EQ(250, loop.get_speed_output());
+
+    // unchanged outputs aren't pushed
+    loop.tick();
+    ASSERT_EQ(3, sw_controller._speed.size());
+    ASSERT_EQ(1, sw_controller._steering.size());
+    ASSERT_EQ(1, hw_controller._speed.size());
+}
+
+TEST(ControlLoop, Disabled)
+{
+    RampTestController controller(false);
+    std::vector<sc::ServoController*> controllers = { &controller };
+    sc::ControlLoop loop(sc::RampConfig(), controllers);
+
+    loop.set_speed_target(700);
+    loop.set_steering_target(100);
+    ASSERT_FALSE(loop.is_active());
+    ASSERT_EQ(std::vector<sc::Setpoint>({700}), controller._speed);
+    ASSERT_EQ(std::vector<sc::Setpoint>({100}), controller._steering);
+}
+
+} // namespace control_loop_test
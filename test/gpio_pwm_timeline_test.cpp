@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "GPIOPWMTimeline.hpp"
+
+namespace sc = shipcontrol;
+
+namespace gpio_pwm_timeline_test
+{
+
+TEST(GPIOPWMTimeline, MergedEdges)
+{
+    sc::GPIOPWMTimeline timeline;
+    std::vector<int> values(3, 0);
+
+    unsigned int engine = timeline.add_line(20000);
+    unsigned int steering = timeline.add_line(20000);
+    unsigned int disabled = timeline.add_line(20000);
+    timeline.set_enabled(engine, true);
+    timeline.set_enabled(steering, true);
+    timeline.set_duration(engine, 1500);
+    timeline.set_duration(steering, 1000);
+    timeline.set_duration(disabled, 1000);
+
+    timeline.reset(0);
+    ASSERT_EQ(20000000, timeline.get_min_period());
+
+    // rising edges of lines with equal periods are applied together
+    ASSERT_EQ(0, timeline.pop_edges(values));
+    ASSERT_EQ(1, values[engine]);
+    ASSERT_EQ(1, values[steering]);
+    ASSERT_EQ(0, values[disabled]);
+
+    ASSERT_EQ(1000000, timeline.pop_edges(values));
+    ASSERT_EQ(1, values[engine]);
+    ASSERT_EQ(0, values[steering]);
+
+    ASSERT_EQ(1500000, timeline.pop_edges(values));
+    ASSERT_EQ(0, values[engine]);
+    ASSERT_EQ(0, values[steering]);
+
+    // new duration is picked up with the next period
+    timeline.set_duration(engine, 1000);
+    ASSERT_EQ(20000000, timeline.pop_edges(values));
+    ASSERT_EQ(1, values[engine]);
+    ASSERT_EQ(1, values[steering]);
+    ASSERT_EQ(21000000, timeline.pop_edges(values));
+    ASSERT_EQ(0, values[engine]);
+    ASSERT_EQ(0, values[steering]);
+    ASSERT_EQ(40000000, timeline.next_edge_time());
+}
+
+TEST(GPIOPWMTimeline, Durations)
+{
+    sc::GPIOPWMTimeline timeline;
+    std::vector<int> values(2, 1);
+
+    unsigned int fast = timeline.add_line(1000);
+    unsigned int slow = timeline.add_line(3000);
+    timeline.set_enabled(fast, true);
+    timeline.set_enabled(slow, true);
+
+    // duration is clamped to the period
+    timeline.set_duration(slow, 5000);
+    ASSERT_EQ(2999, timeline.get_duration(slow));
+
+    // zero duration keeps the line low
+    timeline.set_duration(fast, 0);
+    timeline.reset(1000);
+    ASSERT_EQ(1000000, timeline.get_min_period());
+    ASSERT_EQ(1000, timeline.pop_edges(values));
+    ASSERT_EQ(0, values[fast]);
+    ASSERT_EQ(1, values[slow]);
+    ASSERT_EQ(1001000, timeline.pop_edges(values));
+    ASSERT_EQ(0, values[fast]);
+    ASSERT_EQ(1, values[slow]);
+    ASSERT_EQ(2001000, timeline.pop_edges(values));
+    ASSERT_EQ(3000000, timeline.pop_edges(values));
+    ASSERT_EQ(0, values[slow]);
+    ASSERT_EQ(3001000, timeline.next_edge_time());
+}
+
+} // namespace gpio_pwm_timeline_test
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "GPIOUtil.hpp"
+
+namespace sc = shipcontrol;
+
+namespace gpio_util_test
+{
+
+// fake sysfs PWM chip directory with regular files instead of attributes
+class GPIOSysfsPWMTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        char tmpl[] = "/tmp/scpwmXXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(tmpl));
+        _chip_path = tmpl;
+        ASSERT_EQ(0, mkdir((_chip_path + "/pwm1").c_str(), 0755));
+        for (const char *name : { "/export", "/pwm1/period", "/pwm1/duty_cycle", "/pwm1/enable" })
+        {
+            std::ofstream f(_chip_path + name);
+        }
+    }
+
+    virtual void TearDown()
+    {
+        for (const char *name : { "/export", "/pwm1/period", "/pwm1/duty_cycle", "/pwm1/enable" })
+        {
+            unlink((_chip_path + name).c_str());
+        }
+        rmdir((_chip_path + "/pwm1").c_str());
+        rmdir(_chip_path.c_str());
+    }
+
+    std::string read_file(const char *name)
+    {
+        // values are newline-terminated, stale bytes may follow a shorter one
+        std::ifstream f(_chip_path + name);
+        std::string line;
+        std::getline(f, line);
+        return line;
+    }
+
+    std::string _chip_path;
+};
+
+TEST_F(GPIOSysfsPWMTest, Writes)
+{
+    sc::GPIOSysfsPWM pwm(_chip_path, 1);
+    ASSERT_EQ("1", read_file("/export"));
+
+    pwm.enable(20000000, 1000000);
+    ASSERT_EQ("20000000", read_file("/pwm1/period"));
+    ASSERT_EQ("1000000", read_file("/pwm1/duty_cycle"));
+    ASSERT_EQ("1", read_file("/pwm1/enable"));
+
+    // values are written at the start of the file, as sysfs expects
+    pwm.set_duty_cycle(1500000);
+    ASSERT_EQ("1500000", read_file("/pwm1/duty_cycle"));
+    pwm.set_duty_cycle(1999999);
+    ASSERT_EQ("1999999", read_file("/pwm1/duty_cycle"));
+    // a shorter value is read back without digits of the previous one
+    pwm.set_duty_cycle(999000);
+    ASSERT_EQ("999000", read_file("/pwm1/duty_cycle"));
+
+    pwm.disable();
+    ASSERT_EQ("0", read_file("/pwm1/enable"));
+}
+
+} // namespace gpio_util_test
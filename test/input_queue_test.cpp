@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include "InputQueue.hpp"
+#include "Clock.hpp"
+
+namespace sc = shipcontrol;
+
+namespace input_queue_test
+{
+
+TEST(InputQueue, Order)
+{
+    sc::InputQueue queue(8);
+
+    ASSERT_TRUE(queue.is_empty());
+    ASSERT_EQ(sc::InputEventType::UNKNOWN, queue.pop().type);
+
+    // go around the ring several times
+    for (int lap = 0; lap < 4; lap++)
+    {
+        ASSERT_TRUE(queue.push(sc::InputEvent{sc::InputEventType::SPEED_UP}));
+        ASSERT_TRUE(queue.push(sc::InputEvent{sc::InputEventType::TURN_LEFT}));
+        ASSERT_TRUE(queue.push(sc::InputEvent{sc::InputEventType::SET_SPEED, 500}));
+        ASSERT_FALSE(queue.is_empty());
+
+        ASSERT_EQ(sc::InputEventType::SPEED_UP, queue.pop().type);
+        ASSERT_EQ(sc::InputEventType::TURN_LEFT, queue.pop_blocking().type);
+        sc::InputEvent evt = queue.pop();
+        ASSERT_EQ(sc::InputEventType::SET_SPEED, evt.type);
+        ASSERT_EQ(500, evt.speed);
+        ASSERT_TRUE(queue.is_empty());
+    }
+}
+
+TEST(InputQueue, Overflow)
+{
+    sc::InputQueue queue(4);
+
+    ASSERT_EQ(4, queue.get_capacity());
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(queue.push(sc::InputEvent{sc::InputEventType::TURN_RIGHT}));
+    }
+    // the newest event is rejected, the queued ones are kept
+    ASSERT_FALSE(queue.push(sc::InputEvent{sc::InputEventType::TURN_LEFT}));
+    ASSERT_FALSE(queue.push(sc::InputEvent{sc::InputEventType::TURN_LEFT}));
+    ASSERT_EQ(2, queue.get_dropped());
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(sc::InputEventType::TURN_RIGHT, queue.pop().type);
+    }
+    ASSERT_TRUE(queue.is_empty());
+    ASSERT_TRUE(queue.push(sc::InputEvent{sc::InputEventType::TURN_LEFT}));
+    ASSERT_EQ(sc::InputEventType::TURN_LEFT, queue.pop().type);
+}
+
+// several producers against a blocking consumer
+TEST(InputQueue, MultipleProducers)
+{
+    const int producers = 4;
+    const int events_per_producer = 10000;
+    sc::InputQueue queue(64);
+    std::vector<std::thread *> threads;
+
+    for (int i = 0; i < producers; i++)
+    {
+        threads.push_back(new std::thread([&queue, events_per_producer]()
+        {
+            for (int j = 0; j < events_per_producer; j++)
+            {
+                // spin until the consumer frees some space
+                while (queue.push(sc::InputEvent{sc::InputEventType::SPEED_UP}) == false)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    for (int i = 0; i < producers * events_per_producer; i++)
+    {
+        ASSERT_EQ(sc::InputEventType::SPEED_UP, queue.pop_blocking().type);
+    }
+    ASSERT_TRUE(queue.is_empty());
+
+    for (auto thr : threads)
+    {
+        thr->join();
+        delete thr;
+    }
+}
+
+TEST(InputQueue, Deadline)
+{
+    sc::InputQueue queue(4);
+    sc::InputEvent evt;
+
+    // empty queue times out no earlier than the deadline
+    long long deadline = sc::monotonic_now() + 20000000LL;
+    ASSERT_FALSE(queue.pop_until(evt, deadline));
+    ASSERT_GE(sc::monotonic_now(), deadline);
+
+    // event pushed while waiting wakes the consumer up
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.push(sc::InputEvent{sc::InputEventType::SPEED_DOWN});
+    });
+    ASSERT_TRUE(queue.pop_until(evt, sc::monotonic_now() + 5000000000LL));
+    ASSERT_EQ(sc::InputEventType::SPEED_DOWN, evt.type);
+    producer.join();
+}
+
+} // namespace input_queue_test
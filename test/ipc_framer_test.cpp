@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "IPCMessageFramer.hpp"
+
+namespace sc = shipcontrol;
+
+namespace ipc_framer_test
+{
+
+void feed(sc::IPCMessageFramer &framer, const std::string &data)
+{
+    std::memcpy(framer.get_write_ptr(data.size()), data.data(), data.size());
+    framer.commit(data.size());
+}
+
+// newline-delimited and unterminated messages in a single chunk
+TEST(IPCMessageFramer, Coalesced)
+{
+    sc::IPCMessageFramer framer;
+    std::string_view msg;
+
+    feed(framer, "{\"type\":\"query\"}\n{\"type\":\"cmd\",\"cmd\":\"speed_up\"}{\"type\":\"query\"}\n\n  garbage\n");
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("{\"type\":\"query\"}", msg);
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("{\"type\":\"cmd\",\"cmd\":\"speed_up\"}", msg);
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("{\"type\":\"query\"}", msg);
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("garbage", msg);
+    ASSERT_FALSE(framer.next(msg));
+}
+
+// message split between reads, braces and quotes inside strings
+TEST(IPCMessageFramer, Split)
+{
+    sc::IPCMessageFramer framer;
+    std::string_view msg;
+
+    feed(framer, "{\"type\":\"cmd\",\"data\":\"}\\\"{");
+    ASSERT_FALSE(framer.next(msg));
+    feed(framer, "\",\n\"cmd\":");
+    ASSERT_FALSE(framer.next(msg));
+    feed(framer, "\"set_speed\"}{\"ty");
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("{\"type\":\"cmd\",\"data\":\"}\\\"{\",\n\"cmd\":\"set_speed\"}", msg);
+    ASSERT_FALSE(framer.next(msg));
+    feed(framer, "pe\":\"query\"}");
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_EQ("{\"type\":\"query\"}", msg);
+    ASSERT_FALSE(framer.is_overflow());
+}
+
+TEST(IPCMessageFramer, Overflow)
+{
+    sc::IPCMessageFramer framer(16);
+    std::string_view msg;
+
+    feed(framer, "{\"type\":\"query\"}");
+    ASSERT_TRUE(framer.next(msg));
+    ASSERT_FALSE(framer.is_overflow());
+    feed(framer, "{\"type\":\"query\",");
+    ASSERT_FALSE(framer.next(msg));
+    ASSERT_FALSE(framer.is_overflow());
+    feed(framer, "\"x\":1");
+    ASSERT_FALSE(framer.next(msg));
+    ASSERT_TRUE(framer.is_overflow());
+}
+
+} // namespace ipc_framer_test
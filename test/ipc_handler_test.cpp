@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2023 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -19,7 +19,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
 #include "IPCRequestHandler.hpp"
+#include "Clock.hpp"
 #include "ConsoleLog.hpp"
 #include "json.hpp"
 
@@ -33,18 +36,46 @@ namespace ipc_handler_test
 class TestDataProvider: public sc::DataProvider
 {
 public:
-    virtual sc::SpeedVal get_speed();
-    virtual sc::SteeringVal get_steering();
+    virtual sc::Setpoint get_speed_setpoint();
+    virtual sc::Setpoint get_steering_setpoint();
+    virtual bool get_maestro_telemetry(sc::MaestroTelemetryData &data);
+    virtual sc::LatencyStats *get_latency_stats() { return _has_latency ? &_latency : nullptr; }
+
+    bool _has_telemetry = false;
+    bool _has_latency = false;
+    sc::LatencyStats _latency;
 };
 
-sc::SpeedVal TestDataProvider::get_speed()
+sc::Setpoint TestDataProvider::get_speed_setpoint()
 {
-    return sc::SpeedVal::FWD100;
+    return 1000;
 }
 
-sc::SteeringVal TestDataProvider::get_steering()
+sc::Setpoint TestDataProvider::get_steering_setpoint()
 {
-    return sc::SteeringVal::RIGHT50;
+    // rounded to right50 in JSON responses
+    return 460;
+}
+
+bool TestDataProvider::get_maestro_telemetry(sc::MaestroTelemetryData &data)
+{
+    if (_has_telemetry == false)
+    {
+        return false;
+    }
+
+    data = sc::MaestroTelemetryData{};
+    data.channel_count = 2;
+    data.channels[0] = 1;
+    data.positions[0] = 6000;
+    data.channels[1] = 4;
+    data.positions[1] = 4800;
+    data.moving = true;
+    data.errors = 0x10;
+    data.polls = 7;
+    data.timeouts = 1;
+    data.updated = sc::monotonic_now();
+    return true;
 }
 
 // test fixture
@@ -122,7 +153,7 @@ TEST_F(IPCHandlerTest, ValidCommand)
     sc::InputEvent evt = _input_queue.pop();
     ASSERT_TRUE(_input_queue.is_empty());
     ASSERT_EQ(sc::InputEventType::SET_SPEED, evt.type);
-    ASSERT_EQ("rev20", evt.data);
+    ASSERT_EQ(-200, evt.speed);
 
     rq["type"] = "cmd";
     rq["cmd"] = "set_steering";
@@ -133,7 +164,7 @@ TEST_F(IPCHandlerTest, ValidCommand)
     evt = _input_queue.pop();
     ASSERT_TRUE(_input_queue.is_empty());
     ASSERT_EQ(sc::InputEventType::SET_STEERING, evt.type);
-    ASSERT_EQ("left70", evt.data);
+    ASSERT_EQ(-700, evt.steering);
 }
 
 TEST_F(IPCHandlerTest, InvalidCommand)
@@ -189,4 +220,210 @@ TEST_F(IPCHandlerTest, Query)
     ASSERT_EQ("right50", resp["steering"]);
 }
 
+// requests the fast parser doesn't handle go through the full JSON parser
+TEST_F(IPCHandlerTest, ParserFallback)
+{
+    sc::IPCRequest rq;
+
+    ASSERT_TRUE(sc::IPCRequestParser::parse(" { \"cmd\" : \"set_speed\", \"data\":\"fwd10\",\"type\":\"cmd\"}\r", rq));
+    ASSERT_TRUE(rq.has_type && rq.has_cmd && rq.has_data);
+    ASSERT_EQ("cmd", rq.type);
+    ASSERT_EQ("set_speed", rq.cmd);
+    ASSERT_EQ("fwd10", rq.data);
+    ASSERT_FALSE(sc::IPCRequestParser::parse("{\"type\":\"query\",\"n\":1}", rq));
+    ASSERT_FALSE(sc::IPCRequestParser::parse("{\"type\":\"cmd\",\"cmd\":\"sp\\u0065ed_up\"}", rq));
+    ASSERT_FALSE(sc::IPCRequestParser::parse("{\"type\":\"query\"} x", rq));
+
+    json resp = json::parse(_handler->handleRequest("{\"type\":\"cmd\",\"cmd\":\"set_speed\",\"data\":\"fwd\\u0031\\u0030\"}"));
+    ASSERT_EQ("ok", resp["status"]);
+    sc::InputEvent evt = _input_queue.pop();
+    ASSERT_EQ(sc::InputEventType::SET_SPEED, evt.type);
+    ASSERT_EQ(100, evt.speed);
+
+    resp = json::parse(_handler->handleRequest("{\"type\":\"query\",\"id\":17}"));
+    ASSERT_EQ("fwd100", resp["speed"]);
+
+    resp = json::parse(_handler->handleRequest("{\"type\":1}"));
+    ASSERT_EQ("fail", resp["status"]);
+    resp = json::parse(_handler->handleRequest("{\"type\":\"query\""));
+    ASSERT_EQ("fail", resp["status"]);
+    ASSERT_TRUE(_input_queue.is_empty());
+}
+
+TEST_F(IPCHandlerTest, QueueFull)
+{
+    sc::InputQueue queue(2);
+    sc::IPCRequestHandler handler(queue, _data_provider);
+    json rq;
+    json resp;
+
+    rq["type"] = "cmd";
+    rq["cmd"] = "speed_up";
+    for (std::size_t i = 0; i < queue.get_capacity(); i++)
+    {
+        resp = json::parse(handler.handleRequest(rq.dump()));
+        ASSERT_EQ("ok", resp["status"]);
+    }
+    resp = json::parse(handler.handleRequest(rq.dump()));
+    ASSERT_EQ("fail", resp["status"]);
+    ASSERT_EQ("queue full", resp["error"]);
+
+    sc::IPCBinaryRequest request{};
+    sc::IPCBinaryReply reply;
+    request.magic = IPC_BINARY_MAGIC;
+    request.opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::SPEED_UP);
+    handler.handleRequest(request, reply);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::FAIL), reply.status);
+
+    queue.pop();
+    handler.handleRequest(request, reply);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::OK), reply.status);
+}
+
+TEST_F(IPCHandlerTest, CachedQuery)
+{
+    sc::QueryCache cache;
+    sc::IPCRequestHandler handler(_input_queue, _data_provider, &cache);
+    json rq;
+    json resp;
+
+    rq["type"] = "query";
+    // nothing published yet, data provider is used
+    resp = json::parse(handler.handleRequest(rq.dump()));
+    ASSERT_EQ("fwd100", resp["speed"]);
+
+    cache.publish(-500, -249);
+    resp = json::parse(handler.handleRequest(rq.dump()));
+    ASSERT_EQ("rev50", resp["speed"]);
+    ASSERT_EQ("left20", resp["steering"]);
+
+    cache.publish(0, 0);
+    resp = json::parse(handler.handleRequest(rq.dump()));
+    ASSERT_EQ("stop", resp["speed"]);
+    ASSERT_EQ("straight", resp["steering"]);
+    ASSERT_EQ(2, cache.get_version());
+}
+
+TEST_F(IPCHandlerTest, CachedBinaryQuery)
+{
+    sc::QueryCache cache;
+    sc::IPCRequestHandler handler(_input_queue, _data_provider, &cache);
+    sc::IPCBinaryRequest request{};
+    sc::IPCBinaryReply reply;
+
+    request.magic = IPC_BINARY_MAGIC;
+    request.opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::QUERY);
+    request.seq = 3;
+
+    // nothing published yet, data provider is used
+    handler.handleRequest(request, reply);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::OK), reply.status);
+    ASSERT_EQ(3, reply.seq);
+    ASSERT_EQ(1000, reply.speed);
+    ASSERT_EQ(460, reply.steering);
+
+    cache.publish(-513, 249);
+    handler.handleRequest(request, reply);
+    ASSERT_EQ(-513, reply.speed);
+    ASSERT_EQ(249, reply.steering);
+}
+
+TEST_F(IPCHandlerTest, TelemetryQuery)
+{
+    json rq;
+    json resp;
+
+    rq["type"] = "query";
+    rq["cmd"] = "telemetry";
+    resp = json::parse(_handler->handleRequest(rq.dump()));
+    ASSERT_EQ("fail", resp["status"]);
+
+    _data_provider._has_telemetry = true;
+    resp = json::parse(_handler->handleRequest(rq.dump()));
+    ASSERT_EQ("ok", resp["status"]);
+    ASSERT_EQ(2, resp["positions"].size());
+    ASSERT_EQ(4, resp["positions"][1]["channel"]);
+    ASSERT_EQ(4800, resp["positions"][1]["position"]);
+    ASSERT_EQ(true, resp["moving"]);
+    ASSERT_EQ(0x10, resp["errors"]);
+    ASSERT_EQ(7, resp["polls"]);
+    ASSERT_EQ(1, resp["timeouts"]);
+    ASSERT_LT(resp["age_ms"].get<long long>(), 1000);
+}
+
+TEST_F(IPCHandlerTest, LatencyQuery)
+{
+    json rq;
+    json resp;
+
+    rq["type"] = "query";
+    rq["cmd"] = "latency";
+    resp = json::parse(_handler->handleRequest(rq.dump()));
+    ASSERT_EQ("fail", resp["status"]);
+
+    // latency stats are taken from the data provider on construction
+    _data_provider._has_latency = true;
+    sc::IPCRequestHandler handler(_input_queue, _data_provider);
+
+    // command received 2 ms ago
+    long long received = sc::monotonic_now() - 2000000;
+    json cmd;
+    cmd["type"] = "cmd";
+    cmd["cmd"] = "speed_up";
+    resp = json::parse(handler.handleRequest(cmd.dump(), received));
+    ASSERT_EQ("ok", resp["status"]);
+    sc::InputEvent evt = _input_queue.pop();
+    ASSERT_EQ(sc::InputSource::IPC, evt.source);
+    ASSERT_EQ(received, evt.time);
+    ASSERT_GE(evt.queued, received);
+
+    resp = json::parse(handler.handleRequest(rq.dump()));
+    ASSERT_EQ("ok", resp["status"]);
+    ASSERT_EQ(5, resp["stages"].size());
+    ASSERT_EQ(1, resp["stages"]["ipc"]["count"]);
+    ASSERT_GE(resp["stages"]["ipc"]["max"].get<long long>(), 2000000);
+    ASSERT_GE(resp["stages"]["ipc"]["p99"].get<long long>(), resp["stages"]["ipc"]["p50"].get<long long>());
+    ASSERT_EQ(0, resp["stages"]["evdev"]["count"]);
+}
+
+// readers never see a torn snapshot while the writer republishes
+TEST(QueryCache, Concurrent)
+{
+    sc::QueryCache cache;
+    std::atomic<bool> done(false);
+
+    cache.publish(100, 100);
+    std::thread writer([&cache, &done]() {
+        for (int i = 0; i < 20000; i++)
+        {
+            if (i & 1)
+            {
+                cache.publish(100, 100);
+            }
+            else
+            {
+                cache.publish(-1000, -1000);
+            }
+        }
+        done = true;
+    });
+
+    std::string resp;
+    while (done == false)
+    {
+        ASSERT_TRUE(cache.read(resp));
+        json j = json::parse(resp);
+        if (j["speed"] == "fwd10")
+        {
+            ASSERT_EQ("right10", j["steering"]);
+        }
+        else
+        {
+            ASSERT_EQ("rev100", j["speed"]);
+            ASSERT_EQ("left100", j["steering"]);
+        }
+    }
+    writer.join();
+}
+
 } // namespace ipc_handler_test
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "Journal.hpp"
+
+namespace sc = shipcontrol;
+
+namespace journal_test
+{
+
+class JournalTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        char tmpl[] = "/tmp/scjournalXXXXXX";
+        int fd = mkstemp(tmpl);
+        ASSERT_NE(-1, fd);
+        close(fd);
+        _path = tmpl;
+        _config.path = _path;
+        _config.entries = 4;
+    }
+
+    virtual void TearDown()
+    {
+        unlink(_path.c_str());
+        unlink((_path + ".1").c_str());
+    }
+
+    std::string _path;
+    sc::JournalConfig _config;
+};
+
+TEST_F(JournalTest, Record)
+{
+    {
+        sc::Journal journal(_config);
+        ASSERT_TRUE(journal.is_ok());
+        journal.record_command(sc::InputSource::IPC, sc::InputEventType::SET_SPEED, 300);
+        journal.record_output(sc::JournalEntryKind::SPEED_OUTPUT, "gpio_engine3", 300);
+        // names are truncated to the entry field
+        journal.record_output(sc::JournalEntryKind::STEERING_OUTPUT, "a_very_long_controller_name", -100);
+    }
+
+    std::vector<sc::JournalEntry> entries;
+    ASSERT_TRUE(sc::Journal::read(_path, entries));
+    ASSERT_EQ(3, entries.size());
+
+    ASSERT_EQ(1, entries[0].seq);
+    ASSERT_EQ(sc::JournalEntryKind::COMMAND, entries[0].kind);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::InputSource::IPC), entries[0].source);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::InputEventType::SET_SPEED), entries[0].command);
+    ASSERT_EQ(300, entries[0].setpoint);
+
+    ASSERT_EQ(2, entries[1].seq);
+    ASSERT_EQ(sc::JournalEntryKind::SPEED_OUTPUT, entries[1].kind);
+    ASSERT_STREQ("gpio_engine3", entries[1].controller);
+    ASSERT_EQ(300, entries[1].setpoint);
+    ASSERT_LE(entries[0].time, entries[1].time);
+
+    ASSERT_EQ(sc::JournalEntryKind::STEERING_OUTPUT, entries[2].kind);
+    ASSERT_EQ("a_very_long_cont", std::string(entries[2].controller, sizeof(entries[2].controller)));
+    ASSERT_EQ(-100, entries[2].setpoint);
+}
+
+TEST_F(JournalTest, Wraparound)
+{
+    {
+        sc::Journal journal(_config);
+        ASSERT_TRUE(journal.is_ok());
+        for (int i = 0; i < 10; i++)
+        {
+            journal.record_command(sc::InputSource::EVDEV, sc::InputEventType::SPEED_UP, i);
+        }
+    }
+
+    // only the latest entries are kept
+    std::vector<sc::JournalEntry> entries;
+    ASSERT_TRUE(sc::Journal::read(_path, entries));
+    ASSERT_EQ(4, entries.size());
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(7 + i, entries[i].seq);
+        ASSERT_EQ(6 + i, entries[i].setpoint);
+    }
+}
+
+// the journal of the previous run is kept on restart
+TEST_F(JournalTest, Rotation)
+{
+    {
+        sc::Journal journal(_config);
+        journal.record_command(sc::InputSource::IPC, sc::InputEventType::SET_SPEED, 300);
+    }
+    {
+        sc::Journal journal(_config);
+        journal.record_command(sc::InputSource::EVDEV, sc::InputEventType::SPEED_UP, 100);
+        journal.record_command(sc::InputSource::EVDEV, sc::InputEventType::SPEED_UP, 200);
+    }
+
+    std::vector<sc::JournalEntry> entries;
+    ASSERT_TRUE(sc::Journal::read(_path + ".1", entries));
+    ASSERT_EQ(1, entries.size());
+    ASSERT_EQ(300, entries[0].setpoint);
+
+    std::vector<sc::JournalEntry> current;
+    ASSERT_TRUE(sc::Journal::read(_path, current));
+    ASSERT_EQ(2, current.size());
+    ASSERT_EQ(200, current[1].setpoint);
+}
+
+// zero entries or sync period are rejected, nothing is recorded
+TEST_F(JournalTest, InvalidConfig)
+{
+    _config.sync_period = 0;
+    sc::Journal no_sync(_config);
+    ASSERT_FALSE(no_sync.is_ok());
+    no_sync.record_command(sc::InputSource::IPC, sc::InputEventType::SET_SPEED, 300);
+
+    _config.sync_period = 1000;
+    _config.entries = 0;
+    sc::Journal no_entries(_config);
+    ASSERT_FALSE(no_entries.is_ok());
+}
+
+TEST_F(JournalTest, InvalidFile)
+{
+    FILE *f = fopen(_path.c_str(), "w");
+    ASSERT_NE(nullptr, f);
+    fputs("not a journal", f);
+    fclose(f);
+
+    std::vector<sc::JournalEntry> entries;
+    ASSERT_FALSE(sc::Journal::read(_path, entries));
+    ASSERT_FALSE(sc::Journal::read(_path + ".missing", entries));
+}
+
+} // namespace journal_test
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "LatencyHistogram.hpp"
+
+namespace sc = shipcontrol;
+
+namespace latency_histogram_test
+{
+
+TEST(LatencyHistogram, Percentiles)
+{
+    sc::LatencyHistogram histogram;
+
+    ASSERT_EQ(0, histogram.get_count());
+    ASSERT_EQ(0, histogram.get_percentile(0.99));
+
+    // 1 us ... 1000 us
+    for (std::uint64_t i = 1; i <= 1000; i++)
+    {
+        histogram.record(i * 1000);
+    }
+
+    ASSERT_EQ(1000, histogram.get_count());
+    ASSERT_EQ(1000000, histogram.get_max());
+    // reported values are bucket upper bounds, within 1/16 of the exact value
+    std::uint64_t p50 = histogram.get_percentile(0.5);
+    ASSERT_GE(p50, 500000);
+    ASSERT_LE(p50, 500000 + 500000 / 16);
+    std::uint64_t p99 = histogram.get_percentile(0.99);
+    ASSERT_GE(p99, 990000);
+    ASSERT_LE(p99, 1000000);
+    ASSERT_EQ(1000000, histogram.get_percentile(1.0));
+
+    // small values are exact
+    histogram.reset();
+    histogram.record(0);
+    histogram.record(7);
+    ASSERT_EQ(0, histogram.get_percentile(0.5));
+    ASSERT_EQ(7, histogram.get_percentile(0.99));
+    histogram.record(~0ULL);
+    ASSERT_EQ(~0ULL, histogram.get_max());
+}
+
+} // namespace latency_histogram_test
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Log.hpp"
+
+namespace sc = shipcontrol;
+
+namespace log_test
+{
+
+// collects formatted messages
+class TestBackend : public sc::LogBackend
+{
+public:
+    virtual void write(const char *fmt, va_list args)
+    {
+        char buf[512];
+        vsnprintf(buf, sizeof(buf), fmt, args);
+        _messages.push_back(buf);
+    }
+
+    std::vector<std::string> _messages;
+};
+
+static int evaluated = 0;
+
+static int side_effect()
+{
+    evaluated++;
+    return evaluated;
+}
+
+// fixture, backend is removed even if a test fails
+class LogTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        _log = sc::Log::getInstance();
+        _log->add_backend(&_backend);
+    }
+
+    virtual void TearDown()
+    {
+        _log->set_level(sc::LogLevel::NOTICE);
+        _log->remove_backend(&_backend);
+        sc::Log::release();
+    }
+
+    sc::Log *_log;
+    TestBackend _backend;
+};
+
+TEST_F(LogTest, Filtering)
+{
+    sc::Log *log = _log;
+    TestBackend &backend = _backend;
+    evaluated = 0;
+
+    log->set_level(sc::LogLevel::NOTICE);
+    ASSERT_FALSE(log->is_enabled(sc::LogLevel::DEBUG));
+    ASSERT_TRUE(log->is_enabled(sc::LogLevel::ERROR));
+
+    // arguments of filtered messages aren't evaluated
+    LOG_DEBUG(log, "debug %d\n", side_effect());
+    ASSERT_EQ(0, evaluated);
+    ASSERT_TRUE(backend._messages.empty());
+
+    LOG_NOTICE(log, "notice %d\n", side_effect());
+    ASSERT_EQ(1, evaluated);
+    ASSERT_EQ(std::vector<std::string>({"notice 1\n"}), backend._messages);
+
+    log->set_level(sc::LogLevel::ERROR);
+    LOG_NOTICE(log, "notice %d\n", side_effect());
+    LOG_ERROR(log, "error %d\n", side_effect());
+    ASSERT_EQ(2, evaluated);
+    ASSERT_EQ("error 2\n", backend._messages.back());
+}
+
+TEST_F(LogTest, HexDump)
+{
+    sc::Log *log = _log;
+    TestBackend &backend = _backend;
+    log->set_level(sc::LogLevel::DEBUG);
+
+    const unsigned char cmd[] = { 0x84, 0x05, 0x70, 0x2e };
+    log->write_hex(sc::LogLevel::DEBUG, "cmd:", cmd, sizeof(cmd));
+    ASSERT_EQ(std::vector<std::string>({"cmd: 0x84 0x05 0x70 0x2e\n"}), backend._messages);
+
+    log->set_level(sc::LogLevel::NOTICE);
+    log->write_hex(sc::LogLevel::DEBUG, "cmd:", cmd, sizeof(cmd));
+    ASSERT_EQ(1, backend._messages.size());
+}
+
+} // namespace log_test
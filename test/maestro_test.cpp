@@ -21,7 +21,15 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "MaestroController.hpp"
+#include "MaestroCmd.hpp"
+#include "MaestroTelemetry.hpp"
+#include <sys/socket.h>
 #include "ConsoleLog.hpp"
 
 namespace sc = shipcontrol;
@@ -281,4 +289,198 @@ TEST_F(MaestroTest, SteeringTest)
     ASSERT_EQ(sc::SteeringVal::LEFT100, _controller->get_steering());
 }
 
+TEST(MaestroCmdBatch, Encode)
+{
+    unsigned char buf[MAESTRO_BATCH_MAX_TARGETS * MAESTRO_CMD_LEN];
+
+    // targets are sorted by channel, the latest target for a channel wins
+    sc::MaestroCmdBatch batch(-1);
+    batch.add_target(5, 6000);
+    batch.add_target(3, 4000);
+    batch.add_target(4, 1);
+    batch.add_target(4, 8000);
+    ASSERT_EQ(3, batch.size());
+    std::vector<unsigned char> expected = { 0x84, 3, 0x20, 0x1F,
+                                            0x84, 4, 0x40, 0x3E,
+                                            0x84, 5, 0x70, 0x2E };
+    ASSERT_EQ(expected, std::vector<unsigned char>(buf, buf + batch.encode(buf)));
+
+    // consecutive channels are merged into multi-target commands
+    sc::MaestroCmdBatch multi(-1, true);
+    multi.add_target(5, 6000);
+    multi.add_target(3, 4000);
+    multi.add_target(4, 8000);
+    multi.add_target(9, 6000);
+    expected = { 0x9F, 3, 3, 0x20, 0x1F, 0x40, 0x3E, 0x70, 0x2E,
+                 0x84, 9, 0x70, 0x2E };
+    ASSERT_EQ(expected, std::vector<unsigned char>(buf, buf + multi.encode(buf)));
+}
+
+TEST(MaestroCmdBatch, SingleWrite)
+{
+    // in packet mode every write is read back as a separate packet
+    int fds[2];
+    ASSERT_EQ(0, pipe2(fds, O_DIRECT | O_NONBLOCK));
+
+    sc::MaestroCmdBatch batch(fds[1]);
+    for (unsigned char channel = 0; channel < 6; channel++)
+    {
+        batch.add_target(channel, 6000);
+    }
+    ASSERT_TRUE(batch.send());
+    ASSERT_EQ(0, batch.size());
+
+    unsigned char buf[256];
+    ASSERT_EQ(6 * MAESTRO_CMD_LEN, read(fds[0], buf, sizeof(buf)));
+    ASSERT_EQ(-1, read(fds[0], buf, sizeof(buf)));
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+// Maestro device replaced with a FIFO
+class FifoMaestroConfig : public TestMaestroConfig
+{
+public:
+    FifoMaestroConfig(const std::string &path) : _path(path) {}
+    virtual const char *get_maestro_dev() { return _path.c_str(); }
+    virtual bool get_multi_target() { return true; }
+
+    std::string _path;
+};
+
+TEST(MaestroCmdBatch, Controller)
+{
+    char path[] = "/tmp/scmaestroXXXXXX";
+    int tmp_fd = mkstemp(path);
+    ASSERT_NE(-1, tmp_fd);
+    close(tmp_fd);
+    unlink(path);
+    ASSERT_EQ(0, mkfifo(path, 0600));
+
+    int rd_fd = open(path, O_RDONLY | O_NONBLOCK);
+    ASSERT_NE(-1, rd_fd);
+    FifoMaestroConfig config(path);
+    unsigned char buf[256];
+    {
+        sc::MaestroController controller(config);
+        // drop initial stop and straight targets
+        while (read(rd_fd, buf, sizeof(buf)) > 0)
+        {
+        }
+
+        // direction channel 0 and engine channel 1 are merged, engine channel 8 is separate
+        controller.set_speed_setpoint(500);
+        std::vector<unsigned char> expected = { 0x9F, 2, 0, 0x40, 0x3E, 0x30, 0x22,
+                                                0x84, 8, 0x50, 0x28 };
+        ssize_t len = read(rd_fd, buf, sizeof(buf));
+        ASSERT_EQ(expected, std::vector<unsigned char>(buf, buf + ((len > 0) ? len : 0)));
+    }
+
+    close(rd_fd);
+    unlink(path);
+}
+
+// fake Maestro answering telemetry queries over a socket pair
+static void fake_maestro(int fd, int cycles, bool answer_errors)
+{
+    for (int i = 0; i < cycles; i++)
+    {
+        // 2 GETPOS, GETMOVINGSTATE and GETERRORS
+        unsigned char query[6];
+        std::size_t received = 0;
+        while (received < sizeof(query))
+        {
+            ssize_t len = read(fd, query + received, sizeof(query) - received);
+            if (len <= 0)
+            {
+                return;
+            }
+            received += len;
+        }
+
+        // channel number is echoed in the position
+        std::vector<unsigned char> reply = { query[1], 0x17, query[3], 0x17, 1 };
+        if (answer_errors)
+        {
+            reply.push_back(0x02);
+            reply.push_back(0x00);
+        }
+        // replies are split to check reassembly
+        write(fd, reply.data(), 3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        write(fd, reply.data() + 3, reply.size() - 3);
+    }
+}
+
+TEST(MaestroTelemetry, Poll)
+{
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    std::thread maestro(fake_maestro, fds[1], 3, true);
+
+    sc::MaestroTelemetry telemetry(fds[0], std::vector<int>({2, 7}), 10);
+    sc::MaestroTelemetryData data;
+    ASSERT_FALSE(telemetry.get_data(data));
+
+    telemetry.start();
+    for (int i = 0; (i < 200) && ((telemetry.get_data(data) == false) || (data.polls < 3)); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    telemetry.stop();
+    maestro.join();
+
+    ASSERT_EQ(3, data.polls);
+    ASSERT_EQ(0, data.timeouts);
+    ASSERT_EQ(2, data.channel_count);
+    ASSERT_EQ(7, data.channels[1]);
+    ASSERT_EQ(0x1702, data.positions[0]);
+    ASSERT_EQ(0x1707, data.positions[1]);
+    ASSERT_TRUE(data.moving);
+    ASSERT_EQ(2, data.errors);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(MaestroTelemetry, Timeout)
+{
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    // GETERRORS is never answered
+    std::thread maestro(fake_maestro, fds[1], 1, false);
+
+    sc::MaestroTelemetry telemetry(fds[0], std::vector<int>({2, 7}), 10);
+    telemetry.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(MAESTRO_TELEMETRY_TIMEOUT + 50));
+    maestro.join();
+    telemetry.stop();
+
+    // incomplete cycle is never published
+    sc::MaestroTelemetryData data;
+    ASSERT_FALSE(telemetry.get_data(data));
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(MaestroTelemetry, HangUp)
+{
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+    sc::MaestroTelemetry telemetry(fds[0], std::vector<int>({2, 7}), 10);
+    telemetry.start();
+    // device goes away, the poller must stop instead of spinning on POLLHUP
+    close(fds[1]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    telemetry.stop();
+
+    sc::MaestroTelemetryData data;
+    ASSERT_FALSE(telemetry.get_data(data));
+
+    close(fds[0]);
+}
+
 } // namespace maestro_test
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include "Metrics.hpp"
+#include "MetricsListener.hpp"
+#include "InputQueue.hpp"
+
+namespace sc = shipcontrol;
+
+namespace metrics_test
+{
+
+static std::string read_socket(const std::string &name)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, name.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == -1)
+    {
+        close(fd);
+        return "";
+    }
+
+    std::string text;
+    char buf[1024];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) > 0)
+    {
+        text.append(buf, len);
+    }
+    close(fd);
+    return text;
+}
+
+TEST(Metrics, Registry)
+{
+    sc::Metric *counter = sc::Metrics::counter("test_registry_total", "Test counter", "kind=\"a\"");
+    ASSERT_EQ(counter, sc::Metrics::counter("test_registry_total", "Test counter", "kind=\"a\""));
+    sc::Metric *other = sc::Metrics::counter("test_registry_total", "Test counter", "kind=\"b\"");
+    ASSERT_NE(counter, other);
+    sc::Metric *gauge = sc::Metrics::gauge("test_registry_gauge", "Test gauge");
+    sc::Metric *summary = sc::Metrics::summary("test_registry_ns", "Test summary");
+    // the registry is process-wide, so values may be left by a previous run of the test
+    std::int64_t counter_before = counter->get();
+    std::int64_t other_before = other->get();
+    std::uint64_t sum_before = summary->get_histogram()->get_sum();
+    std::uint64_t count_before = summary->get_histogram()->get_count();
+
+    counter->inc();
+    counter->inc(2);
+    other->inc();
+    gauge->set(10);
+    gauge->dec();
+    summary->record(10);
+    summary->record(12);
+
+    std::string text = sc::Metrics::format();
+    // HELP and TYPE are written once per family
+    std::size_t pos = text.find("# TYPE test_registry_total counter\n");
+    ASSERT_NE(std::string::npos, pos);
+    ASSERT_EQ(std::string::npos, text.find("# TYPE test_registry_total", pos + 1));
+    ASSERT_NE(std::string::npos, text.find("# HELP test_registry_total Test counter\n"));
+    ASSERT_NE(std::string::npos,
+              text.find("test_registry_total{kind=\"a\"} " + std::to_string(counter_before + 3) + "\n"));
+    ASSERT_NE(std::string::npos,
+              text.find("test_registry_total{kind=\"b\"} " + std::to_string(other_before + 1) + "\n"));
+    ASSERT_NE(std::string::npos, text.find("# TYPE test_registry_gauge gauge\ntest_registry_gauge 9\n"));
+    ASSERT_NE(std::string::npos, text.find("# TYPE test_registry_ns summary\n"));
+    ASSERT_NE(std::string::npos, text.find("test_registry_ns{quantile=\"0.5\"} 10\n"));
+    ASSERT_NE(std::string::npos, text.find("test_registry_ns_sum " + std::to_string(sum_before + 22) + "\n"));
+    ASSERT_NE(std::string::npos, text.find("test_registry_ns_count " + std::to_string(count_before + 2) + "\n"));
+}
+
+TEST(Metrics, InputQueue)
+{
+    sc::Metric *depth = sc::Metrics::gauge("shipcontrol_input_queue_depth", "");
+    sc::Metric *ipc = sc::Metrics::counter("shipcontrol_input_events_total", "", "source=\"ipc\"");
+    sc::Metric *dropped = sc::Metrics::counter("shipcontrol_input_events_dropped_total", "");
+    std::int64_t depth_before = depth->get();
+    std::int64_t ipc_before = ipc->get();
+    std::int64_t dropped_before = dropped->get();
+
+    {
+        sc::InputQueue queue(2);
+        sc::InputEvent evt{sc::InputEventType::SPEED_UP};
+        evt.source = sc::InputSource::IPC;
+        ASSERT_TRUE(queue.push(evt));
+        ASSERT_TRUE(queue.push(evt));
+        ASSERT_FALSE(queue.push(evt));
+        ASSERT_EQ(depth_before + 2, depth->get());
+        ASSERT_EQ(ipc_before + 2, ipc->get());
+        ASSERT_EQ(dropped_before + 1, dropped->get());
+
+        queue.pop();
+        ASSERT_EQ(depth_before + 1, depth->get());
+    }
+    // remaining events are discarded with the queue
+    ASSERT_EQ(depth_before, depth->get());
+}
+
+TEST(Metrics, Listener)
+{
+    std::string name = "/tmp/scmetrics_test";
+    sc::Metric *counter = sc::Metrics::counter("test_listener_total", "Test counter");
+    counter->inc(5);
+    std::string expected = "test_listener_total " + std::to_string(counter->get()) + "\n";
+
+    sc::MetricsListener listener(name);
+    ASSERT_TRUE(listener.start());
+
+    // every connection gets a complete snapshot
+    for (int i = 0; i < 2; i++)
+    {
+        std::string text = read_socket(name);
+        ASSERT_NE(std::string::npos, text.find(expected));
+        ASSERT_NE(std::string::npos, text.find("# TYPE shipcontrol_input_queue_depth gauge\n"));
+    }
+
+    listener.stop();
+    ASSERT_EQ("", read_socket(name));
+    ASSERT_NE(0, access(name.c_str(), F_OK));
+}
+
+} // namespace metrics_test
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include "ServoController.hpp"
+
+namespace sc = shipcontrol;
+
+namespace servo_controller_test
+{
+
+// records setpoints passed through the compatibility API
+class TestController : public sc::ServoController
+{
+public:
+    virtual void start() {}
+    virtual void stop() {}
+    virtual sc::Setpoint get_speed_setpoint() { return _speed; }
+    virtual void set_speed_setpoint(sc::Setpoint speed) { _speed = speed; }
+    virtual sc::Setpoint get_steering_setpoint() { return _steering; }
+    virtual void set_steering_setpoint(sc::Setpoint steering) { _steering = steering; }
+
+    sc::Setpoint _speed = 0;
+    sc::Setpoint _steering = 0;
+};
+
+TEST(ServoController, Setpoint)
+{
+    TestController controller;
+
+    controller.set_speed(sc::SpeedVal::REV30);
+    ASSERT_EQ(-300, controller._speed);
+    controller.set_steering(sc::SteeringVal::RIGHT100);
+    ASSERT_EQ(1000, controller._steering);
+
+    // enum getters round to the nearest step
+    controller.set_speed_setpoint(349);
+    ASSERT_EQ(sc::SpeedVal::FWD30, controller.get_speed());
+    controller.set_speed_setpoint(-350);
+    ASSERT_EQ(sc::SpeedVal::REV40, controller.get_speed());
+    controller.set_steering_setpoint(-49);
+    ASSERT_EQ(sc::SteeringVal::STRAIGHT, controller.get_steering());
+    controller.set_steering_setpoint(3000);
+    ASSERT_EQ(sc::SteeringVal::RIGHT100, controller.get_steering());
+
+    ASSERT_EQ(1000, sc::ServoController::clamp_setpoint(1001));
+    ASSERT_EQ(-1000, sc::ServoController::clamp_setpoint(-5000));
+    ASSERT_EQ(-999, sc::ServoController::clamp_setpoint(-999));
+}
+
+TEST(ServoController, Strings)
+{
+    for (int i = -10; i <= 10; i++)
+    {
+        sc::SpeedVal speed = static_cast<sc::SpeedVal>(i);
+        std::string name = sc::ServoController::speed_to_str(speed);
+        ASSERT_TRUE(sc::ServoController::validate_speed_str(name));
+        ASSERT_EQ(speed, sc::ServoController::str_to_speed(name));
+
+        sc::SteeringVal steering = static_cast<sc::SteeringVal>(i);
+        name = sc::ServoController::steering_to_str(steering);
+        ASSERT_TRUE(sc::ServoController::validate_steering_str(name));
+        ASSERT_EQ(steering, sc::ServoController::str_to_steering(name));
+    }
+
+    ASSERT_EQ("rev70", sc::ServoController::speed_to_str(sc::SpeedVal::REV70));
+    ASSERT_EQ("right100", sc::ServoController::steering_to_str(sc::SteeringVal::RIGHT100));
+    ASSERT_EQ("", sc::ServoController::speed_to_str(static_cast<sc::SpeedVal>(11)));
+
+    const char *invalid[] = {"", "fwd", "fwd0", "fwd5", "fwd05", "fwd110", "fwd1000", "fwd100x",
+                             "stopp", "left10", "FWD10", "rev10 "};
+    for (const char *str : invalid)
+    {
+        ASSERT_FALSE(sc::ServoController::validate_speed_str(str)) << str;
+    }
+    ASSERT_EQ(sc::SpeedVal::STOP, sc::ServoController::str_to_speed("fwd5"));
+    ASSERT_FALSE(sc::ServoController::validate_steering_str("fwd10"));
+    ASSERT_FALSE(sc::ServoController::validate_steering_str("right"));
+    ASSERT_EQ(sc::SteeringVal::STRAIGHT, sc::ServoController::str_to_steering("left101"));
+}
+
+} // namespace servo_controller_test
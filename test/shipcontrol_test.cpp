@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include "shipcontrol.hpp"
+
+namespace sc = shipcontrol;
+
+namespace shipcontrol_test
+{
+
+// push the events to the queue and fold them into a single target like the main loop does
+static sc::ControlTarget fold_batch(sc::Setpoint speed, sc::Setpoint steering,
+                                    std::initializer_list<sc::InputEvent> events)
+{
+    sc::InputQueue queue(16);
+    for (const sc::InputEvent &evt : events)
+    {
+        EXPECT_TRUE(queue.push(evt));
+    }
+
+    sc::ControlTarget target{speed, steering, false, false};
+    sc::InputEvent evt;
+    while (queue.try_pop(evt))
+    {
+        sc::ShipControl::fold_event(evt, target);
+    }
+    return target;
+}
+
+TEST(ShipControl, FoldRelative)
+{
+    sc::ControlTarget target = fold_batch(0, 0, {
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::TURN_LEFT},
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::TURN_LEFT},
+        sc::InputEvent{sc::InputEventType::SPEED_DOWN},
+        sc::InputEvent{sc::InputEventType::TURN_RIGHT}});
+    ASSERT_EQ(200, target.speed);
+    ASSERT_EQ(-100, target.steering);
+    ASSERT_FALSE(target.speed_set);
+    ASSERT_FALSE(target.steering_set);
+}
+
+// absolute commands replace the relative changes folded before them,
+// relative commands after them apply on top of the absolute value
+TEST(ShipControl, FoldMixed)
+{
+    sc::ControlTarget target = fold_batch(300, 200, {
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::TURN_RIGHT},
+        sc::InputEvent{sc::InputEventType::SET_SPEED, -300},
+        sc::InputEvent{sc::InputEventType::SPEED_DOWN},
+        sc::InputEvent{sc::InputEventType::TURN_RIGHT},
+        sc::InputEvent{sc::InputEventType::SET_STEERING, 0},
+        sc::InputEvent{sc::InputEventType::TURN_LEFT}});
+    ASSERT_EQ(-400, target.speed);
+    ASSERT_EQ(-100, target.steering);
+    ASSERT_TRUE(target.speed_set);
+    ASSERT_TRUE(target.steering_set);
+
+    // the last absolute command wins
+    target = fold_batch(0, 0, {
+        sc::InputEvent{sc::InputEventType::SET_SPEED, 500},
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::SET_SPEED, 100}});
+    ASSERT_EQ(100, target.speed);
+    ASSERT_EQ(0, target.steering);
+    ASSERT_TRUE(target.speed_set);
+    ASSERT_FALSE(target.steering_set);
+}
+
+// every step is clamped, so a burst doesn't overshoot the range
+TEST(ShipControl, FoldClamp)
+{
+    sc::ControlTarget target = fold_batch(900, -900, {
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::SPEED_UP},
+        sc::InputEvent{sc::InputEventType::SPEED_DOWN},
+        sc::InputEvent{sc::InputEventType::TURN_LEFT},
+        sc::InputEvent{sc::InputEventType::TURN_LEFT},
+        sc::InputEvent{sc::InputEventType::TURN_RIGHT}});
+    ASSERT_EQ(900, target.speed);
+    ASSERT_EQ(-900, target.steering);
+}
+
+} // namespace shipcontrol_test
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "SimulatedController.hpp"
+#include "MaestroSimulator.hpp"
+#include "MaestroController.hpp"
+#include "SysfsPWMSimulator.hpp"
+#include "GPIOSteeringController.hpp"
+
+namespace sc = shipcontrol;
+
+namespace simulation_test
+{
+
+// waits for the condition to become true, the simulator decodes commands asynchronously
+bool wait_for(std::function<bool()> condition)
+{
+    for (int i = 0; i < 200; i++)
+    {
+        if (condition())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+class SimMaestroConfig : public sc::MaestroConfig
+{
+public:
+    SimMaestroConfig(bool multi_target, unsigned int telemetry_period, int straight = 1504) :
+        _multi_target(multi_target),
+        _telemetry_period(telemetry_period),
+        _straight(straight)
+    {
+    }
+
+    virtual const char *get_maestro_dev() { return "/nonexistent"; }
+    virtual std::vector<sc::MaestroEngine> get_engine_channels()
+    {
+        return { sc::MaestroEngine{1, sc::MaestroEngine::NO_CHANNEL, false, 1500, 80} };
+    }
+    virtual std::vector<int> get_steering_channels() { return { 5, 6 }; }
+    virtual sc::SteeringCalibration get_steering_calibration() { return sc::SteeringCalibration{_straight, 80}; }
+    virtual int get_direction_high() { return sc::MaestroConfig::DEFAULT_DIR_HIGH; }
+    virtual int get_direction_low() { return sc::MaestroConfig::DEFAULT_DIR_LOW; }
+    virtual bool get_multi_target() { return _multi_target; }
+    virtual unsigned int get_telemetry_period() { return _telemetry_period; }
+
+protected:
+    bool _multi_target;
+    unsigned int _telemetry_period;
+    int _straight;
+};
+
+TEST(Simulation, SimulatedController)
+{
+    sc::SimulatedController controller("test");
+
+    controller.set_speed_setpoint(300);
+    controller.set_steering_setpoint(-2000);
+
+    ASSERT_EQ(300, controller.get_speed_setpoint());
+    ASSERT_EQ(-SETPOINT_MAX, controller.get_steering_setpoint());
+    ASSERT_EQ(2, controller.get_updates());
+}
+
+TEST(Simulation, MaestroTargets)
+{
+    for (bool multi_target : { false, true })
+    {
+        sc::MaestroSimulator simulator;
+        ASSERT_TRUE(simulator.start());
+
+        SimMaestroConfig base_config(multi_target, 0);
+        sc::MaestroSimulatorConfig config(base_config, simulator.get_dev());
+        sc::MaestroController controller(config);
+
+        // controller stops engines and straightens steering on start
+        ASSERT_TRUE(wait_for([&]() { return simulator.get_target(6) == 1504 * 4; }));
+        ASSERT_EQ(1500 * 4, simulator.get_target(1));
+        ASSERT_EQ(1504 * 4, simulator.get_target(5));
+
+        controller.set_steering_setpoint(SETPOINT_MAX);
+        ASSERT_TRUE(wait_for([&]() { return simulator.get_target(6) == 1504 * 4 + 80 * 4 * 10; }));
+        ASSERT_EQ(1504 * 4 + 80 * 4 * 10, simulator.get_target(5));
+        ASSERT_EQ(0, simulator.get_errors());
+    }
+}
+
+TEST(Simulation, MaestroTelemetry)
+{
+    sc::MaestroSimulator simulator;
+    ASSERT_TRUE(simulator.start());
+
+    SimMaestroConfig base_config(true, 10);
+    sc::MaestroSimulatorConfig config(base_config, simulator.get_dev());
+    sc::MaestroController controller(config);
+    controller.start();
+
+    sc::MaestroTelemetryData data;
+    ASSERT_TRUE(wait_for([&]() { return controller.get_telemetry(data) && (data.polls > 0); }));
+    ASSERT_EQ(3, data.channel_count);
+    ASSERT_EQ(1, data.channels[0]);
+    ASSERT_EQ(1500 * 4, data.positions[0]);
+    ASSERT_EQ(1504 * 4, data.positions[1]);
+    ASSERT_FALSE(data.moving);
+    ASSERT_EQ(0, data.errors);
+
+    controller.stop();
+}
+
+// position bytes matching terminal control characters must reach the controller unchanged
+TEST(Simulation, MaestroTelemetryRawBytes)
+{
+    sc::MaestroSimulator simulator;
+    ASSERT_TRUE(simulator.start());
+
+    // straight position is 4404 (0x1134), high byte is XON
+    SimMaestroConfig base_config(false, 10, 1101);
+    sc::MaestroSimulatorConfig config(base_config, simulator.get_dev());
+    sc::MaestroController controller(config);
+    controller.start();
+
+    sc::MaestroTelemetryData data;
+    ASSERT_TRUE(wait_for([&]() { return controller.get_telemetry(data) && (data.positions[1] == 4404); }));
+
+    // 5133 (0x140D), low byte is CR
+    controller.set_steering_setpoint(228);
+    ASSERT_TRUE(wait_for([&]() { return controller.get_telemetry(data) && (data.positions[1] == 5133); }));
+
+    // 4868 (0x1304), high byte is XOFF
+    controller.set_steering_setpoint(145);
+    ASSERT_TRUE(wait_for([&]() { return controller.get_telemetry(data) && (data.positions[1] == 4868); }));
+    ASSERT_EQ(4868, data.positions[2]);
+
+    controller.stop();
+}
+
+TEST(Simulation, SysfsPWM)
+{
+    std::string root = "/dev/shm/sctest-sysfs" + std::to_string(getpid());
+    {
+        sc::SysfsPWMSimulator simulator(root);
+        std::string chip_path = simulator.add_pwm("/sys/class/pwm/pwmchip0", 1);
+        ASSERT_EQ(root + "/pwmchip0", chip_path);
+
+        sc::GPIOSteeringConfig steering_config;
+        steering_config.syspwm_path = chip_path;
+        steering_config.syspwm_num = 1;
+        steering_config.pwm_period = 20000;
+        steering_config.min_duty_cycle = 5;
+        steering_config.max_duty_cycle = 10;
+
+        sc::GPIOSteeringController controller(steering_config);
+        controller.start();
+
+        std::string value;
+        std::ifstream(chip_path + "/export") >> value;
+        ASSERT_EQ("1", value);
+        std::ifstream(chip_path + "/pwm1/period") >> value;
+        ASSERT_EQ("20000000", value);
+        std::ifstream(chip_path + "/pwm1/enable") >> value;
+        ASSERT_EQ("1", value);
+
+        controller.set_steering_setpoint(SETPOINT_MAX);
+        std::ifstream(chip_path + "/pwm1/duty_cycle") >> value;
+        ASSERT_EQ("2000000", value);
+
+        controller.stop();
+    }
+    // created files are removed
+    ASSERT_NE(0, access(root.c_str(), F_OK));
+}
+
+} // namespace simulation_test
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016 - 2023 Mikhail Sapozhnikov
+ * Copyright (C) 2016 - 2026 Mikhail Sapozhnikov
  *
  * This file is part of ship-control.
  *
@@ -21,6 +21,7 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <chrono>
+#include <vector>
 #include <cstring>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -52,6 +53,12 @@ public:
     void disconnect();
     // send message via unix socket and get response
     std::string send_msg(const std::string &msg);
+    // send raw data without waiting for response
+    bool send_raw(const std::string &data);
+    // read count newline-terminated responses
+    std::vector<std::string> read_responses(std::size_t count);
+    // read exactly len bytes
+    bool read_raw(void *buf, std::size_t len);
     bool is_connected() { return _connected; }
 protected:
     int _socket;
@@ -127,6 +134,53 @@ std::string UnsockClient::send_msg(const std::string &msg)
     return ret;
 }
 
+bool UnsockClient::send_raw(const std::string &data)
+{
+    return (write(_socket, data.data(), data.length()) == data.length());
+}
+
+std::vector<std::string> UnsockClient::read_responses(std::size_t count)
+{
+    std::vector<std::string> responses;
+    std::string data;
+    char readbuf[READBUF_SIZE];
+
+    while (responses.size() < count)
+    {
+        std::size_t pos = data.find('\n');
+        if (pos != std::string::npos)
+        {
+            responses.push_back(data.substr(0, pos));
+            data.erase(0, pos + 1);
+            continue;
+        }
+        ssize_t len = read(_socket, readbuf, READBUF_SIZE);
+        if (len <= 0)
+        {
+            _log->write(sc::LogLevel::ERROR, "UnsockTest::read_responses(), failed to read from socket\n");
+            break;
+        }
+        data.append(readbuf, len);
+    }
+
+    return responses;
+}
+
+bool UnsockClient::read_raw(void *buf, std::size_t len)
+{
+    std::size_t received = 0;
+    while (received < len)
+    {
+        ssize_t count = read(_socket, static_cast<char *>(buf) + received, len - received);
+        if (count <= 0)
+        {
+            return false;
+        }
+        received += count;
+    }
+    return true;
+}
+
 // fixture
 class UnsockTest : public ::testing::Test, sc::IPCConfig, sc::DataProvider
 {
@@ -137,8 +191,8 @@ public:
     // shipcontrol::IPCConfig
     virtual std::string get_unix_socket_name() { return std::string(TESTSOCKET_NAME); }
     // shipcontrol::DataProvider
-    virtual sc::SpeedVal get_speed() { return sc::SpeedVal::REV30; }
-    virtual sc::SteeringVal get_steering() { return sc::SteeringVal::LEFT10; }
+    virtual sc::Setpoint get_speed_setpoint() { return -300; }
+    virtual sc::Setpoint get_steering_setpoint() { return -100; }
 protected:
     sc::InputQueue _inputQueue;
     sc::IPCRequestHandler *_requestHandler;
@@ -224,6 +278,133 @@ TEST_F(UnsockTest, CommandMt)
     }
 }
 
+// many simultaneous connections served by the single listener thread
+TEST_F(UnsockTest, ManyClients)
+{
+    std::vector<UnsockClient *> clients;
+
+    for (int i = 0; i < 200; i++)
+    {
+        UnsockClient *client = new UnsockClient();
+        client->connect();
+        clients.push_back(client);
+    }
+
+    json rq;
+    rq["type"] = "query";
+    for (auto client : clients)
+    {
+        json resp = json::parse(client->send_msg(rq.dump()));
+        ASSERT_EQ("rev30", resp["speed"]);
+    }
+    ASSERT_EQ(200, _unixListener->get_client_count());
+
+    for (auto client : clients)
+    {
+        delete client;
+    }
+    // let the listener notice closed connections
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    ASSERT_EQ(0, _unixListener->get_client_count());
+}
+
+// several requests written at once are answered in order
+TEST_F(UnsockTest, Pipelined)
+{
+    UnsockClient client;
+    client.connect();
+
+    std::string batch;
+    batch += "{\"type\":\"cmd\",\"cmd\":\"speed_up\"}\n";
+    batch += "{\"type\":\"query\"}\n";
+    batch += "{\"type\":\"cmd\",\"cmd\":\"bogus\"}\n";
+    // legacy unterminated request
+    batch += "{\"type\":\"cmd\",\"cmd\":\"turn_left\"}";
+    ASSERT_TRUE(client.send_raw(batch));
+
+    std::vector<std::string> responses = client.read_responses(4);
+    ASSERT_EQ(4, responses.size());
+    ASSERT_EQ("ok", json::parse(responses[0])["status"]);
+    ASSERT_EQ("rev30", json::parse(responses[1])["speed"]);
+    ASSERT_EQ("fail", json::parse(responses[2])["status"]);
+    ASSERT_EQ("ok", json::parse(responses[3])["status"]);
+
+    ASSERT_EQ(sc::InputEventType::SPEED_UP, _inputQueue.pop().type);
+    ASSERT_EQ(sc::InputEventType::TURN_LEFT, _inputQueue.pop().type);
+}
+
+// request split between writes and request larger than a single read
+TEST_F(UnsockTest, Split)
+{
+    UnsockClient client;
+    client.connect();
+
+    ASSERT_TRUE(client.send_raw("{\"type\":"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(client.send_raw("\"query\"}\n"));
+    std::vector<std::string> responses = client.read_responses(1);
+    ASSERT_EQ(1, responses.size());
+    ASSERT_EQ("left10", json::parse(responses[0])["steering"]);
+
+    json rq;
+    rq["type"] = "query";
+    rq["padding"] = std::string(3 * sc::IPCClient::BUFSIZE, 'x');
+    ASSERT_TRUE(client.send_raw(rq.dump() + "\n"));
+    responses = client.read_responses(1);
+    ASSERT_EQ(1, responses.size());
+    ASSERT_EQ("rev30", json::parse(responses[0])["speed"]);
+}
+
+// binary protocol requests written at once
+TEST_F(UnsockTest, Binary)
+{
+    UnsockClient client;
+    client.connect();
+
+    sc::IPCBinaryRequest requests[4];
+    std::memset(requests, 0, sizeof(requests));
+    for (int i = 0; i < 4; i++)
+    {
+        requests[i].magic = IPC_BINARY_MAGIC;
+        requests[i].seq = 100 + i;
+        requests[i].timestamp = 123456789ULL * i;
+    }
+    requests[0].opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::SET_SPEED);
+    requests[0].value = -725;
+    requests[1].opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::QUERY);
+    requests[2].opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::SET_STEERING);
+    requests[2].value = 1500;
+    requests[3].opcode = static_cast<std::uint8_t>(sc::IPCBinaryOpcode::TURN_RIGHT);
+
+    std::string data(reinterpret_cast<const char *>(requests), sizeof(requests));
+    // split the last record between writes
+    ASSERT_TRUE(client.send_raw(data.substr(0, data.size() - 5)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(client.send_raw(data.substr(data.size() - 5)));
+
+    sc::IPCBinaryReply replies[4];
+    ASSERT_TRUE(client.read_raw(replies, sizeof(replies)));
+
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(IPC_BINARY_MAGIC, replies[i].magic);
+        ASSERT_EQ(100 + i, replies[i].seq);
+        ASSERT_EQ(123456789ULL * i, replies[i].timestamp);
+        ASSERT_EQ(-300, replies[i].speed);
+        ASSERT_EQ(-100, replies[i].steering);
+    }
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::OK), replies[0].status);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::OK), replies[1].status);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::FAIL), replies[2].status);
+    ASSERT_EQ(static_cast<std::uint8_t>(sc::IPCBinaryStatus::OK), replies[3].status);
+
+    sc::InputEvent evt = _inputQueue.pop();
+    ASSERT_EQ(sc::InputEventType::SET_SPEED, evt.type);
+    ASSERT_EQ(-725, evt.speed);
+    ASSERT_EQ(sc::InputEventType::TURN_RIGHT, _inputQueue.pop().type);
+    ASSERT_TRUE(_inputQueue.is_empty());
+}
+
 // send single query via unix socket and verify result
 void send_query()
 {
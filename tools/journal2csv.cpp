@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Exports ship-control event journal to CSV.
+ * Usage: ship-control-journal2csv <journal file>
+ * For controller output entries the last column holds time elapsed since the
+ * latest command affecting the same axis, i.e. input-to-actuation latency.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Journal.hpp"
+
+namespace sc = shipcontrol;
+
+static const char *kind_name(sc::JournalEntryKind kind)
+{
+    switch (kind)
+    {
+    case sc::JournalEntryKind::COMMAND: return "command";
+    case sc::JournalEntryKind::SPEED_OUTPUT: return "speed_output";
+    case sc::JournalEntryKind::STEERING_OUTPUT: return "steering_output";
+    default: return "unknown";
+    }
+}
+
+static const char *source_name(std::uint8_t source)
+{
+    switch (static_cast<sc::InputSource>(source))
+    {
+    case sc::InputSource::EVDEV: return "evdev";
+    case sc::InputSource::IPC: return "ipc";
+    case sc::InputSource::CMDLINE: return "cmdline";
+    default: return "unknown";
+    }
+}
+
+static const char *command_name(std::uint8_t command)
+{
+    switch (static_cast<sc::InputEventType>(command))
+    {
+    case sc::InputEventType::TURN_RIGHT: return "TURN_RIGHT";
+    case sc::InputEventType::TURN_LEFT: return "TURN_LEFT";
+    case sc::InputEventType::SPEED_UP: return "SPEED_UP";
+    case sc::InputEventType::SPEED_DOWN: return "SPEED_DOWN";
+    case sc::InputEventType::SET_SPEED: return "SET_SPEED";
+    case sc::InputEventType::SET_STEERING: return "SET_STEERING";
+    default: return "UNKNOWN";
+    }
+}
+
+static bool is_speed_command(std::uint8_t command)
+{
+    sc::InputEventType type = static_cast<sc::InputEventType>(command);
+    return (type == sc::InputEventType::SPEED_UP) ||
+           (type == sc::InputEventType::SPEED_DOWN) ||
+           (type == sc::InputEventType::SET_SPEED);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "Usage: %s <journal file>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<sc::JournalEntry> entries;
+    if (sc::Journal::read(argv[1], entries) == false)
+    {
+        std::fprintf(stderr, "Failed to read journal %s\n", argv[1]);
+        return 1;
+    }
+
+    // time of the latest speed and steering commands, 0 if there was none
+    long long last_speed_cmd = 0;
+    long long last_steering_cmd = 0;
+
+    std::printf("seq,time_ns,kind,source,command,setpoint,controller,since_command_ns\n");
+    for (const sc::JournalEntry &entry : entries)
+    {
+        long long since_command = -1;
+        std::string source;
+        std::string command;
+        std::string controller;
+
+        if (entry.kind == sc::JournalEntryKind::COMMAND)
+        {
+            source = source_name(entry.source);
+            command = command_name(entry.command);
+            if (is_speed_command(entry.command))
+            {
+                last_speed_cmd = entry.time;
+            }
+            else
+            {
+                last_steering_cmd = entry.time;
+            }
+        }
+        else
+        {
+            controller.assign(entry.controller, strnlen(entry.controller, sizeof(entry.controller)));
+            long long last_cmd = (entry.kind == sc::JournalEntryKind::SPEED_OUTPUT) ?
+                                 last_speed_cmd : last_steering_cmd;
+            if (last_cmd != 0)
+            {
+                since_command = entry.time - last_cmd;
+            }
+        }
+
+        std::printf("%llu,%lld,%s,%s,%s,%d,%s,",
+                    static_cast<unsigned long long>(entry.seq),
+                    static_cast<long long>(entry.time),
+                    kind_name(entry.kind),
+                    source.c_str(),
+                    command.c_str(),
+                    static_cast<int>(entry.setpoint),
+                    controller.c_str());
+        if (since_command >= 0)
+        {
+            std::printf("%lld", since_command);
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,485 @@
+/*
+ * Copyright (C) 2026 Mikhail Sapozhnikov
+ *
+ * This file is part of ship-control.
+ *
+ * ship-control is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ship-control is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ship-control.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Load generator for ship-control IPC socket.
+ * Opens several connections to the control socket and sends a mix of queries
+ * and speed/steering commands at a constant total rate. Requests are sent on
+ * schedule regardless of responses (open loop), so latency is measured from
+ * the time a request should have been sent and includes queueing delays.
+ * Reports achieved throughput and latency percentiles by request type.
+ * Usage: ship-control-loadgen [options], see --help
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/program_options.hpp>
+
+#include "Clock.hpp"
+#include "Config.hpp"
+#include "LatencyHistogram.hpp"
+#include "ServoController.hpp"
+
+namespace sc = shipcontrol;
+namespace po = boost::program_options;
+
+#define CONFIG_FILE     "/etc/shipcontrol.conf"
+
+// time of waiting for responses to outstanding requests after the run, milliseconds
+#define DRAIN_TIMEOUT   2000
+
+enum RequestType
+{
+    REQUEST_QUERY = 0,
+    REQUEST_SPEED,
+    REQUEST_STEERING,
+    REQUEST_TYPES
+};
+
+static const char *request_type_names[REQUEST_TYPES] = { "query", "set_speed", "set_steering" };
+
+struct LoadConfig
+{
+    std::string socket_name;
+    unsigned int connections;
+    // total requests per second
+    unsigned int rate;
+    unsigned int duration;
+    // percentage of queries, the rest are commands split evenly between speed and steering
+    unsigned int query_percent;
+    unsigned int seed;
+};
+
+struct LoadStats
+{
+    sc::LatencyHistogram latency[REQUEST_TYPES];
+    std::atomic<std::uint64_t> sent;
+    std::atomic<std::uint64_t> errors;
+    std::atomic<std::uint64_t> failed;
+    // receive time of the latest response
+    std::atomic<long long> last_response;
+};
+
+// request sent and not answered yet
+struct Outstanding
+{
+    RequestType type;
+    // scheduled send time
+    long long scheduled;
+};
+
+static void sleep_until(long long time)
+{
+    timespec ts;
+    ts.tv_sec = time / 1000000000LL;
+    ts.tv_nsec = time % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+}
+
+static int connect_socket(const std::string &socket_name)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+    {
+        return -1;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_name.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(sockaddr_un)) == -1)
+    {
+        int err = errno;
+        close(fd);
+        errno = err;
+        return -1;
+    }
+
+    return fd;
+}
+
+static std::string make_request(RequestType type, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> value(-10, 10);
+    switch (type)
+    {
+    case REQUEST_SPEED:
+        return std::string("{\"type\":\"cmd\",\"cmd\":\"set_speed\",\"data\":\"") +
+               sc::ServoController::speed_name(static_cast<sc::SpeedVal>(value(rng))) + "\"}\n";
+    case REQUEST_STEERING:
+        return std::string("{\"type\":\"cmd\",\"cmd\":\"set_steering\",\"data\":\"") +
+               sc::ServoController::steering_name(static_cast<sc::SteeringVal>(value(rng))) + "\"}\n";
+    default:
+        return "{\"type\":\"query\"}\n";
+    }
+}
+
+// single connection: requests are sent by the calling thread, responses are read by a separate one
+class LoadConnection
+{
+public:
+    LoadConnection(const LoadConfig &config, unsigned int index, LoadStats &stats) :
+        _config(config),
+        _index(index),
+        _stats(stats),
+        _fd(-1),
+        _sending(true)
+    {
+    }
+
+    bool open()
+    {
+        _fd = connect_socket(_config.socket_name);
+        return _fd != -1;
+    }
+
+    void run(long long start, long long end)
+    {
+        std::thread receiver(&LoadConnection::receive, this);
+
+        std::mt19937 rng(_config.seed + _index);
+        std::uniform_int_distribution<unsigned int> percent(0, 99);
+        // requests of all connections are spread evenly over the interval
+        long long interval = 1000000000LL * _config.connections / _config.rate;
+        long long scheduled = start + interval * _index / _config.connections;
+
+        while (scheduled < end)
+        {
+            sleep_until(scheduled);
+
+            RequestType type = REQUEST_QUERY;
+            if (percent(rng) >= _config.query_percent)
+            {
+                type = (percent(rng) < 50) ? REQUEST_SPEED : REQUEST_STEERING;
+            }
+            std::string request = make_request(type, rng);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _outstanding.push_back(Outstanding{type, scheduled});
+            }
+            if (send_all(request) == false)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _outstanding.pop_back();
+                _stats.failed.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            _stats.sent.fetch_add(1, std::memory_order_relaxed);
+            scheduled += interval;
+        }
+
+        _sending = false;
+        receiver.join();
+        close(_fd);
+    }
+
+protected:
+    bool send_all(const std::string &data)
+    {
+        std::size_t sent = 0;
+        while (sent < data.size())
+        {
+            ssize_t len = send(_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (len == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            sent += len;
+        }
+        return true;
+    }
+
+    void receive()
+    {
+        char buf[4096];
+        std::string line;
+        long long drain_deadline = 0;
+
+        while (true)
+        {
+            bool empty;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                empty = _outstanding.empty();
+            }
+            if (_sending == false)
+            {
+                if (empty)
+                {
+                    break;
+                }
+                if (drain_deadline == 0)
+                {
+                    drain_deadline = sc::monotonic_now() + DRAIN_TIMEOUT * 1000000LL;
+                }
+                else if (sc::monotonic_now() >= drain_deadline)
+                {
+                    break;
+                }
+            }
+
+            pollfd pfd{_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 10) <= 0)
+            {
+                continue;
+            }
+            ssize_t len = read(_fd, buf, sizeof(buf));
+            if (len <= 0)
+            {
+                break;
+            }
+
+            long long now = sc::monotonic_now();
+            for (ssize_t i = 0; i < len; i++)
+            {
+                if (buf[i] != '\n')
+                {
+                    line.push_back(buf[i]);
+                    continue;
+                }
+                handle_response(line, now);
+                line.clear();
+            }
+        }
+
+        // requests left without response
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.failed.fetch_add(_outstanding.size(), std::memory_order_relaxed);
+        _outstanding.clear();
+    }
+
+    void handle_response(const std::string &response, long long now)
+    {
+        Outstanding request;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_outstanding.empty())
+            {
+                return;
+            }
+            request = _outstanding.front();
+            _outstanding.pop_front();
+        }
+
+        _stats.latency[request.type].record(static_cast<std::uint64_t>(now - request.scheduled));
+        long long last = _stats.last_response.load(std::memory_order_relaxed);
+        while ((now > last) &&
+               (_stats.last_response.compare_exchange_weak(last, now, std::memory_order_relaxed) == false))
+        {
+        }
+        if (response.find("\"fail\"") != std::string::npos)
+        {
+            _stats.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const LoadConfig &_config;
+    unsigned int _index;
+    LoadStats &_stats;
+    int _fd;
+    std::atomic<bool> _sending;
+    std::mutex _mutex;
+    // requests in the order of sending, responses come in the same order
+    std::deque<Outstanding> _outstanding;
+};
+
+static void print_latency(const char *name, const sc::LatencyHistogram &histogram)
+{
+    if (histogram.get_count() == 0)
+    {
+        return;
+    }
+    std::printf("%-14s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                name,
+                static_cast<unsigned long long>(histogram.get_count()),
+                histogram.get_sum() / 1000.0 / histogram.get_count(),
+                histogram.get_percentile(0.5) / 1000.0,
+                histogram.get_percentile(0.9) / 1000.0,
+                histogram.get_percentile(0.99) / 1000.0,
+                histogram.get_percentile(0.999) / 1000.0,
+                histogram.get_max() / 1000.0);
+}
+
+static int parse_options(int argc, char **argv, LoadConfig &config)
+{
+    try
+    {
+        po::variables_map opts;
+        po::options_description opt_descr("Available options:");
+
+        opt_descr.add_options()
+            ("help", "print help message")
+            ("config", po::value<std::string>()->default_value(CONFIG_FILE), "ship-control configuration file to take socket path from")
+            ("socket", po::value<std::string>(), "path to ship-control unix socket, overrides configuration file")
+            ("connections", po::value<unsigned int>()->default_value(4), "number of concurrent connections")
+            ("rate", po::value<unsigned int>()->default_value(1000), "total requests per second")
+            ("duration", po::value<unsigned int>()->default_value(10), "duration of the run in seconds")
+            ("query-percent", po::value<unsigned int>()->default_value(50), "percentage of queries, the rest are speed and steering commands")
+            ("seed", po::value<unsigned int>()->default_value(1), "seed of the request mix, equal seeds give equal request sequences");
+
+        po::store(po::parse_command_line(argc, argv, opt_descr), opts);
+        po::notify(opts);
+
+        if (opts.count("help"))
+        {
+            std::cout << "Usage: " << argv[0] << " [options]\n";
+            std::cout << opt_descr << "\n";
+            return 1;
+        }
+
+        if (opts.count("socket"))
+        {
+            config.socket_name = opts["socket"].as<std::string>();
+        }
+        else
+        {
+            sc::Config sc_config(opts["config"].as<std::string>());
+            if (sc_config.is_ok() == false)
+            {
+                std::cerr << "Failed to read " << opts["config"].as<std::string>() << "\n";
+                return 2;
+            }
+            config.socket_name = sc_config.get_unix_socket_name();
+        }
+        config.connections = opts["connections"].as<unsigned int>();
+        config.rate = opts["rate"].as<unsigned int>();
+        config.duration = opts["duration"].as<unsigned int>();
+        config.query_percent = opts["query-percent"].as<unsigned int>();
+        config.seed = opts["seed"].as<unsigned int>();
+
+        if ((config.connections == 0) || (config.rate == 0) || (config.query_percent > 100))
+        {
+            std::cerr << "connections and rate must be positive, query-percent must not exceed 100\n";
+            return 2;
+        }
+        if (config.rate < config.connections)
+        {
+            config.connections = config.rate;
+        }
+
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    LoadConfig config;
+    int ret = parse_options(argc, argv, config);
+    if (ret != 0)
+    {
+        return (ret == 1) ? 0 : ret;
+    }
+
+    LoadStats stats;
+    stats.sent = 0;
+    stats.errors = 0;
+    stats.failed = 0;
+    stats.last_response = 0;
+
+    std::vector<LoadConnection *> connections;
+    for (unsigned int i = 0; i < config.connections; i++)
+    {
+        LoadConnection *connection = new LoadConnection(config, i, stats);
+        connections.push_back(connection);
+        if (connection->open() == false)
+        {
+            std::cerr << "Failed to connect to " << config.socket_name << ", error code " << errno << "\n";
+            for (LoadConnection *conn : connections)
+            {
+                delete conn;
+            }
+            return 1;
+        }
+    }
+
+    // give all threads time to start before the first scheduled request
+    long long start = sc::monotonic_now() + 10000000LL;
+    long long end = start + config.duration * 1000000000LL;
+    std::vector<std::thread> threads;
+    for (LoadConnection *connection : connections)
+    {
+        threads.emplace_back(&LoadConnection::run, connection, start, end);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    // the rate is taken over the scheduled window or up to the last response if it came later,
+    // waiting for missing responses after that doesn't count
+    long long last_response = stats.last_response.load();
+    double elapsed = (std::max(end, last_response) - start) / 1e9;
+
+    std::uint64_t received = 0;
+    for (const sc::LatencyHistogram &histogram : stats.latency)
+    {
+        received += histogram.get_count();
+    }
+
+    std::printf("socket %s, %u connections, target rate %u requests/s, %u%% queries, duration %u s\n",
+                config.socket_name.c_str(), config.connections, config.rate,
+                config.query_percent, config.duration);
+    std::printf("sent %llu, received %llu, error responses %llu, failed %llu\n",
+                static_cast<unsigned long long>(stats.sent.load()),
+                static_cast<unsigned long long>(received),
+                static_cast<unsigned long long>(stats.errors.load()),
+                static_cast<unsigned long long>(stats.failed.load()));
+    std::printf("achieved %.1f responses/s\n", received / elapsed);
+    std::printf("%-14s %10s %10s %10s %10s %10s %10s %10s\n",
+                "latency, us", "count", "mean", "p50", "p90", "p99", "p99.9", "max");
+    for (int type = 0; type < REQUEST_TYPES; type++)
+    {
+        print_latency(request_type_names[type], stats.latency[type]);
+    }
+
+    for (LoadConnection *connection : connections)
+    {
+        delete connection;
+    }
+
+    return (stats.failed.load() == 0) ? 0 : 1;
+}